@@ -0,0 +1,159 @@
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "display/common/damage_region.h"
+#include "test_check.h"
+
+/**
+ *  Check that a damage_region merge the overlapping and close areas, keep the far apart areas
+ *  separated, and never hold more than max_rect_count disjoint rectangles covering every added area.
+ */
+
+using area = View::damage_region::area;
+
+static bool same_area(const area& a, const area& b)
+{
+    return a.top == b.top && a.bottom == b.bottom && a.left == b.left && a.right == b.right;
+}
+
+//  Rectangles are disjoint, within the cap, and each added area is in one of them
+static bool valid_region(const View::damage_region& region, const std::vector<area>& added)
+{
+    if (region.size() > View::damage_region::max_rect_count)
+        return false;
+
+    for (auto it = region.begin(); it != region.end(); ++it)
+        for (auto other = it + 1; other != region.end(); ++other)
+            if (it->overlap(*other))
+                return false;
+
+    for (const auto& a : added) {
+        bool covered = false;
+        for (const auto& r : region)
+            covered = covered || r.contains(a);
+        if (!covered)
+            return false;
+    }
+
+    return true;
+}
+
+static void check_merge()
+{
+    View::damage_region region{};
+
+    region.add(View::make_rectangle(10, 10, 0, 50));
+    check(region.empty(), "An empty area was added");
+
+    region.add(View::make_rectangle(0, 100, 0, 100));
+    region.add(View::make_rectangle(20, 40, 20, 40));
+    check(region.size() == 1u && same_area(*region.begin(), View::make_rectangle(0, 100, 0, 100)),
+        "An area already damaged was added");
+
+    //  Overlapping areas are always merged
+    region.add(View::make_rectangle(50, 150, 50, 150));
+    check(region.size() == 1u && same_area(*region.begin(), View::make_rectangle(0, 150, 0, 150)),
+        "Overlapping areas were not merged");
+
+    //  A few wasted pixels are cheaper than another rectangle
+    region.clear();
+    region.add(View::make_rectangle(0, 10, 0, 10));
+    region.add(View::make_rectangle(0, 10, 20, 30));
+    check(region.size() == 1u && same_area(region.bounding(), View::make_rectangle(0, 10, 0, 30)),
+        "Close small areas were not merged");
+
+    //  Large areas are merged while the waste is at most half their surface
+    region.clear();
+    region.add(View::make_rectangle(0, 100, 0, 100));
+    region.add(View::make_rectangle(0, 100, 150, 250));
+    check(region.size() == 1u, "Close large areas were not merged");
+
+    //  An area bridging two rectangles is merged with both
+    region.clear();
+    region.add(View::make_rectangle(0, 100, 0, 100));
+    region.add(View::make_rectangle(0, 100, 300, 400));
+    region.add(View::make_rectangle(40, 60, 90, 310));
+    check(region.size() == 1u && same_area(*region.begin(), View::make_rectangle(0, 100, 0, 400)),
+        "An area overlapping two rectangles was not merged with both");
+}
+
+static void check_split()
+{
+    View::damage_region region{};
+    const auto first = View::make_rectangle(0, 10, 0, 10);
+    const auto second = View::make_rectangle(500, 510, 500, 510);
+
+    region.add(first);
+    region.add(second);
+    check(region.size() == 2u, "Far apart areas were merged");
+    check(valid_region(region, {first, second}), "Far apart areas are not covered by the region");
+    check(same_area(region.bounding(), View::make_rectangle(0, 510, 0, 510)), "Wrong region bounding box");
+
+    region.clear();
+    region.add(View::make_rectangle(0, 100, 0, 100));
+    region.add(View::make_rectangle(300, 400, 300, 400));
+    check(region.size() == 2u, "Far apart large areas were merged");
+
+    //  Adding a region add each of its rectangles
+    View::damage_region other{};
+    other.add(View::make_rectangle(0, 10, 600, 610));
+    other.add(View::make_rectangle(50, 150, 50, 150));
+    region.add(other);
+    check(region.size() == 3u, "A region was not added rectangle by rectangle");
+}
+
+static void check_cap()
+{
+    View::damage_region region{};
+    std::vector<area> added{};
+
+    //  Small areas far apart from each other
+    for (auto i = 0; i < 20; ++i) {
+        const auto x = (i % 5) * 200;
+        const auto y = (i / 5) * 200;
+        added.push_back(View::make_rectangle(y, y + 10, x, x + 10));
+        region.add(added.back());
+    }
+
+    check(region.size() == View::damage_region::max_rect_count, "The rectangle count is not capped");
+    check(valid_region(region, added), "A capped region does not cover every area");
+
+    //  Random areas
+    std::mt19937 random{1u};
+    std::uniform_int_distribution<int> position{-50, 1000};
+    std::uniform_int_distribution<int> size{0, 120};
+
+    for (auto step = 0u; step < 200u; ++step) {
+        region.clear();
+        added.clear();
+
+        for (auto i = 0u; i < 30u; ++i) {
+            const auto top = position(random);
+            const auto left = position(random);
+            added.push_back(View::make_rectangle(top, top + size(random), left, left + size(random)));
+            region.add(added.back());
+
+            if (added.back().width() == 0 || added.back().height() == 0)
+                added.pop_back();
+        }
+
+        if (!valid_region(region, added)) {
+            std::cerr << "Invalid region after adding random areas (step " << step << ")" << std::endl;
+            failure_count++;
+            break;
+        }
+    }
+}
+
+int main()
+{
+    check_merge();
+    check_split();
+    check_cap();
+
+    if (failure_count == 0)
+        std::cout << "damage_region : areas are merged, split and capped as expected" << std::endl;
+
+    return failure_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+#include <iostream>
+#include <vector>
+
+#include "view.h"
+#include "null_context.h"
+#include "test_check.h"
+
+/**
+ *  Check that a replayed display_list clip its commands as when they were recorded : by the
+ *  current scissor when the recorded widget did not set any, and by the scissors set by the
+ *  widget otherwise. The commands are drawn with a NanoVG context that discard them.
+ */
+
+//  Scissors given to the renderer
+static std::vector<NVGscissor> rendered_scissors{};
+
+static void capture_fill(
+    void*, NVGpaint*, NVGcompositeOperationState, NVGscissor *scissor,
+    float, const float*, const NVGpath*, int path_count)
+{
+    //  Skip the empty paths used to probe the scissor
+    if (path_count > 0)
+        rendered_scissors.push_back(*scissor);
+}
+
+static bool same_scissors(const std::vector<NVGscissor>& a, const std::vector<NVGscissor>& b)
+{
+    if (a.size() != b.size())
+        return false;
+
+    for (auto i = 0u; i < a.size(); ++i) {
+        for (auto j = 0u; j < 6u; ++j)
+            if (a[i].xform[j] != b[i].xform[j])
+                return false;
+        for (auto j = 0u; j < 2u; ++j)
+            if (a[i].extent[j] != b[i].extent[j])
+                return false;
+    }
+
+    return true;
+}
+
+//  Fill its area, and optionally a part clipped by its own scissor
+class clipping_widget : public View::widget {
+public:
+    explicit clipping_widget(bool nested_scissor)
+    :   View::widget{100.f, 100.f},
+        _nested_scissor{nested_scissor}
+    {}
+
+    void draw(NVGcontext *vg) override
+    {
+        draw_count++;
+        nvgBeginPath(vg);
+        nvgRect(vg, 0.f, 0.f, width(), height());
+        nvgFill(vg);
+
+        if (_nested_scissor) {
+            nvgSave(vg);
+            nvgIntersectScissor(vg, 10.f, 10.f, 20.f, 20.f);
+            nvgBeginPath(vg);
+            nvgRect(vg, 0.f, 0.f, width(), height());
+            nvgFill(vg);
+            nvgRestore(vg);
+        }
+    }
+
+    unsigned int draw_count{0u};
+
+private:
+    const bool _nested_scissor;
+};
+
+//  Draw the widget clipped by a scissor, recording it, and return the rendered scissors
+static std::vector<NVGscissor> draw_clipped(
+    NVGcontext *vg, clipping_widget& w, float scissor_size, View::display_list *list)
+{
+    rendered_scissors.clear();
+    nvgBeginFrame(vg, 200.f, 200.f, 1.f);
+    nvgScissor(vg, 0.f, 0.f, scissor_size, scissor_size);
+
+    if (list != nullptr) {
+        View::display_list::recorder recording{*list, vg};
+        w.draw(vg);
+    }
+    else {
+        w.draw(vg);
+    }
+
+    nvgCancelFrame(vg);
+    return rendered_scissors;
+}
+
+//  Replay the list clipped by a scissor, and return the rendered scissors
+static std::vector<NVGscissor> replay_clipped(
+    NVGcontext *vg, View::display_list& list, float scissor_size, bool& replayed)
+{
+    rendered_scissors.clear();
+    nvgBeginFrame(vg, 200.f, 200.f, 1.f);
+    nvgScissor(vg, 0.f, 0.f, scissor_size, scissor_size);
+    replayed = list.replay(vg);
+    nvgCancelFrame(vg);
+    return rendered_scissors;
+}
+
+static void check_replay(NVGcontext *vg)
+{
+    bool replayed = false;
+
+    //  Without nested scissor, the current scissor is used
+    {
+        clipping_widget w{false};
+        View::display_list list{};
+
+        draw_clipped(vg, w, 50.f, &list);
+        check(!list.has_nested_scissor(), "A list without scissor has a nested scissor");
+
+        const auto replay = replay_clipped(vg, list, 80.f, replayed);
+        check(replayed, "A list without scissor was not replayed with another scissor");
+        check(same_scissors(replay, draw_clipped(vg, w, 80.f, nullptr)), "A list was not clipped by the current scissor");
+    }
+
+    //  With a nested scissor, the recorded scissors are used
+    {
+        clipping_widget w{true};
+        View::display_list list{};
+
+        const auto recorded = draw_clipped(vg, w, 50.f, &list);
+        check(list.has_nested_scissor(), "The nested scissor was not recorded");
+        check(recorded.size() == 2u, "The commands were not rendered while recorded");
+
+        const auto replay = replay_clipped(vg, list, 50.f, replayed);
+        check(replayed, "A list with a nested scissor was not replayed with the same scissor");
+        check(same_scissors(replay, recorded), "A replayed list did not use the recorded scissors");
+
+        replay_clipped(vg, list, 80.f, replayed);
+        check(!replayed, "A list with a nested scissor was replayed with another scissor");
+    }
+}
+
+static void check_wrapper(NVGcontext *vg)
+{
+    auto child = std::make_unique<clipping_widget>(true);
+    auto& w = *child;
+    View::display_list_wrapper wrapper{std::move(child)};
+
+    for (const auto scissor_size : {50.f, 50.f, 80.f}) {
+        rendered_scissors.clear();
+        nvgBeginFrame(vg, 200.f, 200.f, 1.f);
+        nvgScissor(vg, 0.f, 0.f, scissor_size, scissor_size);
+        wrapper.draw(vg);
+        nvgCancelFrame(vg);
+    }
+
+    //  Replayed with the same scissor, drawn again with another
+    check(w.draw_count == 2u, "The wrapper did not draw again a subtree with nested scissors clipped by another scissor");
+}
+
+int main()
+{
+    auto *vg = create_null_context();
+    nvgInternalParams(vg)->renderFill = capture_fill;
+
+    check_replay(vg);
+    check_wrapper(vg);
+
+    nvgDeleteInternal(vg);
+
+    if (failure_count == 0)
+        std::cout << "display_list : replayed commands are clipped as recorded" << std::endl;
+
+    return failure_count == 0 ? 0 : 1;
+}
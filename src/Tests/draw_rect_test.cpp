@@ -0,0 +1,162 @@
+#include <iostream>
+#include <vector>
+
+#include "view.h"
+#include "null_context.h"
+#include "display/common/display_controler.h"
+
+/**
+ *  Check that the containers only redraw the children overlapping with an invalidated area,
+ *  and that the panel children hidden behind an opaque sibling are not drawn.
+ *  The widgets are drawn with a NanoVG context that discard the drawing commands.
+ */
+
+class counting_widget : public View::widget {
+public:
+    counting_widget(float width, float height)
+    :   View::widget{width, height}
+    {}
+
+    void draw(NVGcontext *vg) override
+    {
+        draw_count++;
+        nvgBeginPath(vg);
+        nvgRect(vg, 0.f, 0.f, width(), height());
+        nvgFill(vg);
+    }
+
+    unsigned int draw_count{0u};
+};
+
+//  Stand for the display : record the area invalidated by the widgets
+class recording_display : public View::display_controler {
+public:
+    explicit recording_display(View::widget& root)
+    :   View::display_controler{root}
+    {}
+
+    void invalidate_rect(const View::rectangle<>& rect) override { invalidated = rect; }
+    void set_cursor(View::cursor) override {}
+
+    View::rectangle<> invalidated{};
+};
+
+static std::unique_ptr<View::widget> make_row(std::vector<counting_widget*>& widgets)
+{
+    auto make_cell =
+        [&widgets]()
+        {
+            auto cell = std::make_unique<counting_widget>(50.f, 30.f);
+            widgets.push_back(cell.get());
+            return cell;
+        };
+
+    return View::make_horizontal_layout(make_cell(), make_cell(), make_cell(), make_cell());
+}
+
+static std::unique_ptr<View::widget> make_panel(std::vector<counting_widget*>& widgets)
+{
+    auto panel = std::make_unique<View::panel<>>(200.f, 60.f);
+
+    for (auto i = 0u; i < 8u; ++i) {
+        auto cell = std::make_unique<counting_widget>(20.f, 20.f);
+        widgets.push_back(cell.get());
+        panel->insert_widget(25.f * i, 20.f, std::move(cell));
+    }
+
+    return panel;
+}
+
+static unsigned int total_draw_count(const std::vector<counting_widget*>& widgets)
+{
+    unsigned int count = 0u;
+    for (const auto *w : widgets)
+        count += w->draw_count;
+    return count;
+}
+
+static void reset_draw_count(std::vector<counting_widget*>& widgets)
+{
+    for (auto *w : widgets)
+        w->draw_count = 0u;
+}
+
+int main()
+{
+    std::vector<counting_widget*> widgets{};
+
+    auto content =
+        View::make_vertical_layout(
+            make_row(widgets), make_row(widgets), make_row(widgets), make_panel(widgets));
+    auto root =
+        std::make_unique<View::background>(
+            std::make_unique<View::header>(
+                std::move(content), View::color_theme::color::SURFACE, 12.f, 4.f, 4.f));
+
+    recording_display display{*root};
+    auto *vg = create_null_context();
+    int failure_count = 0;
+
+    const auto frame =
+        [&](auto&& draw)
+        {
+            reset_draw_count(widgets);
+            nvgBeginFrame(vg, root->width(), root->height(), 1.f);
+            draw();
+            nvgEndFrame(vg);
+        };
+
+    //  A full redraw draw every widget once
+    frame([&]() { root->draw(vg); });
+
+    if (total_draw_count(widgets) != widgets.size()) {
+        std::cerr << "Full redraw : " << total_draw_count(widgets) << " draw calls, expected " << widgets.size() << std::endl;
+        failure_count++;
+    }
+
+    //  Invalidating a widget must only redraw this widget
+    for (auto *w : widgets) {
+        w->invalidate();
+        frame([&]() { root->draw_rect(vg, display.invalidated); });
+
+        if (w->draw_count != 1u || total_draw_count(widgets) != 1u) {
+            std::cerr
+                << "Redraw of " << display.invalidated << " : " << total_draw_count(widgets)
+                << " draw calls, expected 1" << std::endl;
+            failure_count++;
+        }
+    }
+
+    //  A widget covered by an opaque sibling is not drawn
+    {
+        View::panel<> pages{100.f, 100.f};
+        std::vector<counting_widget*> hidden_page{};
+        std::vector<counting_widget*> front_page{};
+
+        auto hidden = std::make_unique<counting_widget>(100.f, 100.f);
+        hidden_page.push_back(hidden.get());
+        pages.insert_widget(0.f, 0.f, std::move(hidden));
+
+        auto front = std::make_unique<counting_widget>(100.f, 100.f);
+        front_page.push_back(front.get());
+        pages.insert_widget(0.f, 0.f, std::make_unique<View::background>(std::move(front)));
+
+        reset_draw_count(hidden_page);
+        nvgBeginFrame(vg, pages.width(), pages.height(), 1.f);
+        pages.draw(vg);
+        pages.draw_rect(vg, View::make_rectangle(10.f, 20.f, 10.f, 20.f));
+        nvgEndFrame(vg);
+
+        if (total_draw_count(hidden_page) != 0u || total_draw_count(front_page) != 2u) {
+            std::cerr << "Hidden page drawn " << total_draw_count(hidden_page) << " times" << std::endl;
+            failure_count++;
+        }
+    }
+
+    nvgDeleteInternal(vg);
+
+    if (failure_count == 0)
+        std::cout << "draw_rect : " << widgets.size() << " widgets redrawn alone" << std::endl;
+
+    return failure_count == 0 ? 0 : 1;
+}
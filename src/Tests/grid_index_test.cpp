@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "view.h"
+#include "test_check.h"
+
+/**
+ *  Check that a grid_index find every rectangle containing a position or overlapping an area,
+ *  as a linear search, while rectangles are moved, and that a panel find its children at their
+ *  new position once moved or resized with their holder.
+ */
+
+static View::rectangle<> random_rectangle(std::mt19937& random)
+{
+    std::uniform_real_distribution<float> position{-100.f, 1000.f};
+    std::uniform_real_distribution<float> size{0.f, 150.f};
+    std::uniform_real_distribution<float> large_size{0.f, 1200.f};
+
+    const auto left = position(random);
+    const auto top = position(random);
+
+    //  Some rectangles cover too many cells to be indexed in the cells
+    const auto width = (random() % 16u == 0u) ? large_size(random) : size(random);
+    const auto height = (random() % 16u == 0u) ? large_size(random) : size(random);
+
+    return View::make_rectangle(top, top + height, left, left + width);
+}
+
+//  Every expected identifier must be found, and the result must be sorted without duplicate
+static bool valid_result(const std::vector<std::size_t>& found, const std::vector<std::size_t>& expected)
+{
+    if (!std::is_sorted(found.begin(), found.end()) ||
+        std::adjacent_find(found.begin(), found.end()) != found.end())
+        return false;
+
+    return std::includes(found.begin(), found.end(), expected.begin(), expected.end());
+}
+
+static void check_grid_index()
+{
+    std::mt19937 random{1u};
+    std::uniform_real_distribution<float> position{-200.f, 1200.f};
+    std::vector<View::rectangle<>> rectangles(500u);
+    View::grid_index index{};
+    std::vector<std::size_t> found{};
+    std::vector<std::size_t> expected{};
+
+    for (auto i = 0u; i < rectangles.size(); ++i) {
+        rectangles[i] = random_rectangle(random);
+        index.insert(i, rectangles[i]);
+    }
+
+    check(index.size() == rectangles.size(), "The index size is not the rectangle count");
+
+    for (auto step = 0u; step < 2000u; ++step) {
+        //  Move a rectangle
+        const auto moved = random() % rectangles.size();
+        rectangles[moved] = random_rectangle(random);
+        index.insert(moved, rectangles[moved]);
+
+        //  Rectangles containing a position
+        const auto x = position(random);
+        const auto y = position(random);
+
+        expected.clear();
+        for (auto i = 0u; i < rectangles.size(); ++i)
+            if (x >= rectangles[i].left && x <= rectangles[i].right && y >= rectangles[i].top && y <= rectangles[i].bottom)
+                expected.push_back(i);
+
+        index.at(x, y, found);
+        if (!valid_result(found, expected)) {
+            std::cerr << "Wrong rectangles at (" << x << ", " << y << ")" << std::endl;
+            failure_count++;
+        }
+
+        //  Rectangles overlapping an area
+        const auto area = random_rectangle(random);
+        View::rectangle<> intersection;
+
+        expected.clear();
+        for (auto i = 0u; i < rectangles.size(); ++i)
+            if (area.intersect(rectangles[i], intersection))
+                expected.push_back(i);
+
+        index.overlapping(area, found);
+        if (!valid_result(found, expected)) {
+            std::cerr << "Wrong rectangles overlapping an area" << std::endl;
+            failure_count++;
+        }
+    }
+
+    //  Edges are included, as with widget::contains
+    View::grid_index edges{};
+    edges.insert(0u, View::make_rectangle(0.f, 64.f, 0.f, 64.f));
+    edges.at(64.f, 64.f, found);
+    check(found == std::vector<std::size_t>{0u}, "A rectangle is not found at its bottom right corner");
+
+    edges.clear();
+    edges.at(10.f, 10.f, found);
+    check(edges.size() == 0u && found.empty(), "A cleared index is not empty");
+}
+
+class probe_widget : public View::widget {
+public:
+    probe_widget()
+    :   View::widget{20.f, 20.f}
+    {}
+
+    bool on_mouse_move(float, float) override
+    {
+        move_count++;
+        return true;
+    }
+
+    unsigned int move_count{0u};
+};
+
+//  The first move focus the child under the mouse, the second one is delivered to it
+static bool hit(View::panel<>& panel, probe_widget& probe, float x, float y)
+{
+    probe.move_count = 0u;
+    panel.on_mouse_move(x, y);
+    panel.on_mouse_move(x, y);
+    return probe.move_count != 0u;
+}
+
+static void check_panel()
+{
+    View::panel<> panel{1000.f, 1000.f};
+    auto child = std::make_unique<probe_widget>();
+    auto& probe = *child;
+    auto& holder = panel.insert_widget(10.f, 10.f, std::move(child));
+
+    check(hit(panel, probe, 15.f, 15.f), "A panel child is not found at its position");
+
+    //  Moved far away, in other grid cells, without being invalidated
+    holder.set_pos(500.f, 700.f);
+    check(!hit(panel, probe, 15.f, 15.f), "A moved panel child is found at its previous position");
+    check(hit(panel, probe, 510.f, 710.f), "A moved panel child is not found at its new position");
+
+    holder.set_pos_x(800.f);
+    check(hit(panel, probe, 810.f, 710.f), "A panel child moved horizontally is not found at its new position");
+
+    holder.set_pos_y(100.f);
+    check(hit(panel, probe, 810.f, 110.f), "A panel child moved vertically is not found at its new position");
+
+    //  Resized over other grid cells
+    holder.resize(150.f, 150.f);
+    check(hit(panel, probe, 940.f, 240.f), "A resized panel child is not found in its new area");
+}
+
+int main()
+{
+    check_grid_index();
+    check_panel();
+
+    if (failure_count == 0)
+        std::cout << "grid_index : every rectangle is found, and panel children are found once moved" << std::endl;
+
+    return failure_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,150 @@
+#include <iostream>
+#include <vector>
+
+#include "view.h"
+
+/**
+ *  Check that a linear_layout place, resize and route the events to its children as the
+ *  equivalent chain of pair_layout.
+ */
+
+constexpr auto child_count = 6u;
+
+class probe_widget : public View::widget {
+public:
+    probe_widget(float width, float height, View::size_constraint width_constraint)
+    :   View::widget{width, height, width_constraint, View::free_size}
+    {}
+
+    bool on_mouse_move(float, float) override
+    {
+        move_count++;
+        return true;
+    }
+
+    unsigned int move_count{0u};
+};
+
+static std::unique_ptr<View::widget> make_probe(std::vector<probe_widget*>& probes, unsigned int index)
+{
+    //  Alternate free, bounded and frozen widths
+    const auto width = 40.f + 10.f * index;
+    const auto constraint =
+        index % 3u == 0u ? View::free_size :
+        index % 3u == 1u ? View::size_constraint{20.f, 80.f} :
+        View::size_constraint::frozen(width);
+
+    auto probe = std::make_unique<probe_widget>(width, 30.f, constraint);
+    probes.push_back(probe.get());
+    return probe;
+}
+
+template <typename TMakeLayout>
+static std::unique_ptr<View::widget> make_row(std::vector<probe_widget*>& probes, TMakeLayout make_layout)
+{
+    //  Probes are created in order, as the arguments evaluation order is unspecified
+    std::unique_ptr<View::widget> children[child_count];
+    for (auto i = 0u; i < child_count; ++i)
+        children[i] = make_probe(probes, i);
+
+    return make_layout(
+        std::move(children[0]), std::move(children[1]), std::move(children[2]),
+        std::move(children[3]), std::move(children[4]), std::move(children[5]));
+}
+
+static bool same_geometry(
+    const View::widget& pair_root, const std::vector<probe_widget*>& pair_probes,
+    const View::widget& linear_root, const std::vector<probe_widget*>& linear_probes)
+{
+    if (pair_root.width() != linear_root.width() || pair_root.height() != linear_root.height())
+        return false;
+
+    //  Child positions in the pair chain are relative to the nested layouts
+    auto pair_x = 0.f;
+
+    for (auto i = 0u; i < child_count; ++i) {
+        const auto *p = pair_probes[i];
+        const auto *l = linear_probes[i];
+
+        if (p->width() != l->width() || p->height() != l->height() || pair_x != l->pos_x())
+            return false;
+
+        pair_x += p->width();
+    }
+
+    return true;
+}
+
+int main()
+{
+    std::vector<probe_widget*> pair_probes{};
+    std::vector<probe_widget*> linear_probes{};
+    auto pair_root = make_row(pair_probes, [](auto&& ...c) { return View::make_horizontal_layout(std::move(c)...); });
+    auto linear_root = make_row(linear_probes, [](auto&& ...c) { return View::make_horizontal_linear_layout(std::move(c)...); });
+    int failure_count = 0;
+
+    if (!same_geometry(*pair_root, pair_probes, *linear_root, linear_probes)) {
+        std::cerr << "Initial geometry differ" << std::endl;
+        failure_count++;
+    }
+
+    //  Resize
+    for (const auto width : {300.f, 260.f, 420.f, 1000.f, 350.f}) {
+        const auto pair_resized = pair_root->resize(width, 40.f);
+        const auto linear_resized = linear_root->resize(width, 40.f);
+
+        if (pair_resized != linear_resized ||
+            !same_geometry(*pair_root, pair_probes, *linear_root, linear_probes))
+        {
+            std::cerr << "Geometry differ after resize to " << width << std::endl;
+            failure_count++;
+        }
+    }
+
+    //  Hit testing : the same child, or the separator, must receive each event.
+    //  Each nested pair_layout focus its child on a move before forwarding the next ones,
+    //  so the moves are repeated and only the last one is compared.
+    for (auto x = 0.f; x < linear_root->width(); x += 0.5f) {
+        for (auto i = 0u; i < child_count; ++i) {
+            pair_root->on_mouse_move(x, 10.f);
+            linear_root->on_mouse_move(x, 10.f);
+        }
+
+        for (auto *probe : pair_probes)
+            probe->move_count = 0u;
+        for (auto *probe : linear_probes)
+            probe->move_count = 0u;
+
+        pair_root->on_mouse_move(x, 10.f);
+        linear_root->on_mouse_move(x, 10.f);
+
+        for (auto i = 0u; i < child_count; ++i) {
+            if (pair_probes[i]->move_count != linear_probes[i]->move_count) {
+                std::cerr << "Mouse move at " << x << " routed differently" << std::endl;
+                failure_count++;
+            }
+        }
+    }
+
+    //  Separator drag
+    for (const auto separator_x : {40.f, 90.f, 150.f}) {
+        for (const auto dx : {-15.f, 25.f}) {
+            for (auto *root : {pair_root.get(), linear_root.get()}) {
+                root->on_mouse_move(separator_x, 10.f);
+                root->on_mouse_drag_start(View::mouse_button::left, separator_x, 10.f);
+                root->on_mouse_drag(View::mouse_button::left, separator_x + dx, 10.f, dx, 0.f);
+                root->on_mouse_drag_end(View::mouse_button::left, separator_x + dx, 10.f);
+            }
+
+            if (!same_geometry(*pair_root, pair_probes, *linear_root, linear_probes)) {
+                std::cerr << "Geometry differ after dragging the separator at " << separator_x << std::endl;
+                failure_count++;
+            }
+        }
+    }
+
+    if (failure_count == 0)
+        std::cout << "linear_layout : same geometry and events as pair_layout" << std::endl;
+
+    return failure_count == 0 ? 0 : 1;
+}
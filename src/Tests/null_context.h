@@ -0,0 +1,34 @@
+#ifndef VIEW_TESTS_NULL_CONTEXT_H_
+#define VIEW_TESTS_NULL_CONTEXT_H_
+
+#include <cstring>
+
+#include <nanovg.h>
+
+/**
+ *  \brief Create a NanoVG context that discard the drawing commands, to run the widgets
+ *  drawing code without any graphic device. Delete it with nvgDeleteInternal
+ */
+inline NVGcontext *create_null_context()
+{
+    NVGparams params;
+    std::memset(&params, 0, sizeof(params));
+
+    params.renderCreate = [](void*) { return 1; };
+    params.renderCreateTexture = [](void*, int, int, int, int, const unsigned char*) { return 1; };
+    params.renderDeleteTexture = [](void*, int) { return 1; };
+    params.renderUpdateTexture = [](void*, int, int, int, int, int, const unsigned char*) { return 1; };
+    params.renderGetTextureSize = [](void*, int, int *w, int *h) { *w = 1; *h = 1; return 1; };
+    params.renderViewport = [](void*, float, float, float) {};
+    params.renderCancel = [](void*) {};
+    params.renderFlush = [](void*) {};
+    params.renderFill = [](void*, NVGpaint*, NVGcompositeOperationState, NVGscissor*, float, const float*, const NVGpath*, int) {};
+    params.renderStroke = [](void*, NVGpaint*, NVGcompositeOperationState, NVGscissor*, float, float, const NVGpath*, int) {};
+    params.renderTriangles = [](void*, NVGpaint*, NVGcompositeOperationState, NVGscissor*, const NVGvertex*, int, float) {};
+    params.renderDelete = [](void*) {};
+    params.edgeAntiAlias = 1;
+
+    return nvgCreateInternal(&params);
+}
+
+#endif
@@ -0,0 +1,98 @@
+#include <chrono>
+#include <iostream>
+
+#include "view.h"
+#include "drawing/shadow_cache.h"
+
+/**
+ *  Compare the NanoVG renderers by drawing a dense widget scene into an offscreen surface,
+ *  with the shadows drawn from the shadow_cache images and with the NanoVG gradients.
+ */
+
+constexpr auto scene_width = 1280.f;
+constexpr auto scene_height = 800.f;
+constexpr auto warmup_frame_count = 10u;
+constexpr auto frame_count = 200u;
+
+static std::unique_ptr<View::panel<>> make_dense_scene()
+{
+    auto scene = std::make_unique<View::panel<>>(scene_width, scene_height);
+    constexpr auto cell_width = 80.f;
+    constexpr auto cell_height = 100.f;
+
+    for (auto y = 0.f; y + cell_height <= scene_height; y += cell_height) {
+        for (auto x = 0.f; x + cell_width <= scene_width; x += cell_width) {
+            scene->insert_widget(x + 12.f, y, std::make_unique<View::knob>());
+            scene->insert_widget(x + 4.f, y + 58.f, std::make_unique<View::label>(72.f, 16.f, "Parameter"));
+            scene->insert_widget(x + 4.f, y + 78.f, std::make_unique<View::checkbox>());
+            scene->insert_widget(x + 26.f, y + 78.f, std::make_unique<View::text_push_button>("Set", 48.f, 18.f));
+        }
+    }
+
+    return scene;
+}
+
+static const char *renderer_name(View::gl_version renderer)
+{
+    return renderer == View::gl_version::gl3 ? "OpenGL 3 (core)" : "OpenGL 2";
+}
+
+static void benchmark(View::gl_version requested_renderer, bool cached_shadows)
+{
+    using clock = std::chrono::steady_clock;
+
+    if (!View::gl_renderer_available(requested_renderer)) {
+        std::cout << renderer_name(requested_renderer) << " : not built (NANOVG_WITH_GL3=OFF)" << std::endl;
+        return;
+    }
+
+    auto scene = make_dense_scene();
+    View::offscreen_backend backend{*scene, 1.f, requested_renderer};
+    backend.create_window("");
+
+    if (backend.renderer() != requested_renderer) {
+        std::cout << renderer_name(requested_renderer) << " : not supported by the driver" << std::endl;
+        return;
+    }
+
+    //  The offscreen surface is drawn by this thread
+    View::thread_shadow_cache().set_enabled(cached_shadows);
+
+    for (auto i = 0u; i < warmup_frame_count; ++i)
+        backend.render_all();
+
+    const auto start = clock::now();
+
+    for (auto i = 0u; i < frame_count; ++i)
+        backend.render_all();
+
+    const auto elapsed = std::chrono::duration<double, std::milli>{clock::now() - start}.count();
+    const auto stats = backend.get_frame_statistics();
+
+    std::cout
+        << renderer_name(requested_renderer)
+        << (cached_shadows ? ", cached shadows" : ", gradient shadows") << " : "
+        << elapsed / frame_count << " ms/frame ("
+        << 1000. * frame_count / elapsed << " fps), cpu draw "
+        << stats.average_draw_time.count() << " us, gpu wait "
+        << stats.average_swap_time.count() << " us" << std::endl;
+}
+
+int main()
+{
+    std::cout << "Drawing " << frame_count << " frames of a dense scene ("
+        << scene_width << "x" << scene_height << ")" << std::endl;
+
+    try {
+        for (const auto cached_shadows : {false, true}) {
+            benchmark(View::gl_version::gl2, cached_shadows);
+            benchmark(View::gl_version::gl3, cached_shadows);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Benchmark failed : " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
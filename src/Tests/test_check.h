@@ -0,0 +1,22 @@
+#ifndef VIEW_TESTS_TEST_CHECK_H_
+#define VIEW_TESTS_TEST_CHECK_H_
+
+#include <iostream>
+
+/**
+ *  \brief Number of failed checks : the test fails if it is not 0
+ */
+inline int failure_count = 0;
+
+/**
+ *  \brief Report and count a failed condition, and go on with the test
+ */
+inline void check(bool condition, const char *message)
+{
+    if (!condition) {
+        std::cerr << message << std::endl;
+        failure_count++;
+    }
+}
+
+#endif
@@ -0,0 +1,120 @@
+#include <string>
+
+#include "drawing/text_cache.h"
+#include "internal_fonts/internal_fonts.h"
+#include "null_context.h"
+#include "test_check.h"
+
+/**
+ *  Check that a text_cache only hit the measurements of the same context, font, size, scale and
+ *  text, that it evict the least recently used entry at capacity, and that it return the metrics
+ *  measured by NanoVG with the default text alignment and letter spacing, whatever the current ones.
+ *  The fonts are measured with a NanoVG context that discard the drawing commands.
+ */
+
+static NVGcontext *create_context_with_fonts()
+{
+    auto *vg = create_null_context();
+    View::create_roboto_regular_font(vg);
+    View::create_roboto_bold_font(vg);
+    return vg;
+}
+
+static void check_keys(NVGcontext *vg, NVGcontext *other_vg)
+{
+    View::text_cache cache{};
+
+    cache.measure(vg, 0, 14.f, "Parameter");
+    cache.measure(vg, 0, 14.f, "Parameter");
+    check(cache.miss_count() == 1u && cache.hit_count() == 1u, "The same measurement was not cached");
+
+    cache.measure(vg, 1, 14.f, "Parameter");
+    cache.measure(vg, 0, 15.f, "Parameter");
+    cache.measure(vg, 0, 14.f, "Parameters");
+    cache.measure(other_vg, 0, 14.f, "Parameter");
+    check(cache.miss_count() == 5u && cache.hit_count() == 1u,
+        "A measurement was hit with another font, size, text or context");
+
+    //  NanoVG measure the text at the display resolution
+    nvgSave(vg);
+    nvgScale(vg, 2.f, 2.f);
+    cache.measure(vg, 0, 14.f, "Parameter");
+    check(cache.miss_count() == 6u, "A measurement was hit at another scale");
+    nvgRestore(vg);
+
+    cache.measure(vg, 0, 14.f, "Parameter");
+    check(cache.hit_count() == 2u && cache.size() == 6u, "A measurement was lost by the other ones");
+
+    cache.clear();
+    cache.measure(vg, 0, 14.f, "Parameter");
+    check(cache.size() == 1u && cache.miss_count() == 7u, "A cleared cache hit a measurement");
+}
+
+static void check_eviction(NVGcontext *vg)
+{
+    View::text_cache cache{3u};
+
+    cache.measure(vg, 0, 14.f, "a");
+    cache.measure(vg, 0, 14.f, "b");
+    cache.measure(vg, 0, 14.f, "c");
+    cache.measure(vg, 0, 14.f, "a");    //  b is now the least recently used
+    cache.measure(vg, 0, 14.f, "d");
+
+    check(cache.size() == 3u, "The cache grew beyond its capacity");
+
+    cache.measure(vg, 0, 14.f, "a");
+    cache.measure(vg, 0, 14.f, "c");
+    cache.measure(vg, 0, 14.f, "d");
+    check(cache.hit_count() == 4u && cache.miss_count() == 4u, "A recently used measurement was evicted");
+
+    cache.measure(vg, 0, 14.f, "b");
+    check(cache.miss_count() == 5u, "The least recently used measurement was not evicted");
+}
+
+static bool same_metrics(const View::text_metrics& metrics, float advance, const float bounds[4])
+{
+    return
+        metrics.advance == advance &&
+        metrics.bounds[0] == bounds[0] && metrics.bounds[1] == bounds[1] &&
+        metrics.bounds[2] == bounds[2] && metrics.bounds[3] == bounds[3];
+}
+
+static void check_metrics(NVGcontext *vg)
+{
+    const std::string text{"Parameter"};
+    float bounds[4];
+
+    nvgFontFaceId(vg, 0);
+    nvgFontSize(vg, 14.f);
+    nvgTextAlign(vg, NVG_ALIGN_LEFT | NVG_ALIGN_BASELINE);
+    nvgTextLetterSpacing(vg, 0.f);
+    const auto advance = nvgTextBounds(vg, 0.f, 0.f, text.data(), text.data() + text.size(), bounds);
+
+    View::text_cache cache{};
+    check(same_metrics(cache.measure(vg, 0, 14.f, text), advance, bounds), "The measured metrics are not NanoVG ones");
+
+    //  Measured with the defaults, as expected by draw_text
+    nvgTextAlign(vg, NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE);
+    nvgTextLetterSpacing(vg, 3.f);
+    cache.clear();
+    check(same_metrics(cache.measure(vg, 0, 14.f, text), advance, bounds),
+        "The metrics depend on the text alignment or letter spacing set before");
+}
+
+int main()
+{
+    auto *vg = create_context_with_fonts();
+    auto *other_vg = create_context_with_fonts();
+
+    check_keys(vg, other_vg);
+    check_eviction(vg);
+    check_metrics(vg);
+
+    nvgDeleteInternal(other_vg);
+    nvgDeleteInternal(vg);
+
+    if (failure_count == 0)
+        std::cout << "text_cache : measurements are cached by context, font, scale and text" << std::endl;
+
+    return failure_count == 0 ? 0 : 1;
+}
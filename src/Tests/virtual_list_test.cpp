@@ -0,0 +1,208 @@
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "view.h"
+#include "null_context.h"
+
+/**
+ *  Check that a virtual_list only create the widgets of the displayed items, bind them to the
+ *  right items when scrolled, and find the item under the mouse, with a list and a grid of
+ *  10000 items of various heights.
+ */
+
+constexpr auto item_count = 10000u;
+constexpr auto list_width = 200.f;
+constexpr auto list_height = 300.f;
+
+class item_widget : public View::widget {
+public:
+    item_widget()
+    :   View::widget{10.f, 10.f}
+    {}
+
+    void draw(NVGcontext*) override { draw_count++; }
+
+    bool on_mouse_enter() override
+    {
+        hovered = true;
+        return true;
+    }
+
+    bool on_mouse_exit() override
+    {
+        hovered = false;
+        return true;
+    }
+
+    std::size_t item{0u};
+    unsigned int draw_count{0u};
+    bool hovered{false};
+};
+
+class test_model : public View::virtual_list_model {
+public:
+    std::size_t item_count() const override { return ::item_count; }
+
+    std::unique_ptr<View::widget> create_item_widget() override
+    {
+        auto w = std::make_unique<item_widget>();
+        widgets.push_back(w.get());
+        return w;
+    }
+
+    void bind_item(View::widget& w, std::size_t item) override
+    {
+        static_cast<item_widget&>(w).item = item;
+        bind_count++;
+    }
+
+    float row_height(std::size_t row) const override { return 16.f + static_cast<float>(row % 7u) * 3.f; }
+
+    std::vector<item_widget*> widgets{};
+    unsigned int bind_count{0u};
+};
+
+static int check_row_offset_index()
+{
+    std::mt19937 random{1u};
+    std::uniform_real_distribution<float> height{0.f, 40.f};
+    std::vector<float> heights(1000u);
+
+    for (auto& h : heights)
+        h = std::floor(height(random));
+
+    View::row_offset_index index{};
+    index.assign(std::vector<float>{heights});
+
+    for (auto i = 0u; i < 200u; ++i) {
+        const auto row = random() % heights.size();
+        heights[row] = std::floor(height(random));
+        index.set_height(row, heights[row]);
+    }
+
+    auto offset = 0.f;
+
+    for (auto row = 0u; row < heights.size(); ++row) {
+        if (index.offset(row) != offset) {
+            std::cerr << "row_offset_index : offset of row " << row << " is " << index.offset(row) << ", expected " << offset << std::endl;
+            return 1;
+        }
+
+        if (heights[row] > 0.f && (index.row_at(offset) != row || index.row_at(offset + heights[row] - 0.5f) != row)) {
+            std::cerr << "row_offset_index : wrong row at offset " << offset << std::endl;
+            return 1;
+        }
+
+        offset += heights[row];
+    }
+
+    return 0;
+}
+
+//  Item displayed at a position, found by scanning the rows
+static std::size_t expected_item_at(const test_model& model, std::size_t column_count, float x, float content_y)
+{
+    auto offset = 0.f;
+    std::size_t row = 0u;
+
+    while (offset + model.row_height(row) <= content_y) {
+        offset += model.row_height(row);
+        row++;
+    }
+
+    const auto column = static_cast<std::size_t>(x / (list_width / static_cast<float>(column_count)));
+    return row * column_count + column;
+}
+
+static int check_list(NVGcontext *vg, std::size_t column_count)
+{
+    test_model model{};
+    View::virtual_list list{model, list_width, list_height, column_count};
+    int failure_count = 0;
+
+    //  Only the displayed widgets, and one more row, are created
+    const auto max_widget_count = (static_cast<std::size_t>(list_height / 16.f) + 2u) * column_count;
+
+    std::mt19937 random{2u};
+    std::vector<std::size_t> targets{0u, 1u, 57u, item_count / 2u, item_count - 1u};
+    for (auto i = 0u; i < 20u; ++i)
+        targets.push_back(random() % item_count);
+
+    for (const auto target : targets) {
+        list.scroll_to_item(target);
+
+        //  The displayed widgets are bound to the items under them
+        for (auto x = 5.f; x < list_width; x += list_width / static_cast<float>(column_count)) {
+            for (auto y = 0.5f; y < list_height; y += 7.f) {
+                for (auto i = 0u; i < 2u; ++i)
+                    list.on_mouse_move(x, y);
+
+                const auto expected = expected_item_at(model, column_count, x, y + list.scroll_offset());
+                item_widget *hovered = nullptr;
+
+                for (auto *w : model.widgets)
+                    if (w->hovered)
+                        hovered = w;
+
+                if (expected < item_count && (hovered == nullptr || hovered->item != expected)) {
+                    std::cerr
+                        << "Columns " << column_count << ", scrolled to " << target << " : item at (" << x << ", " << y
+                        << ") is " << (hovered ? static_cast<long>(hovered->item) : -1l) << ", expected " << expected << std::endl;
+                    failure_count++;
+                }
+            }
+        }
+
+        //  Only the displayed items are drawn
+        for (auto *w : model.widgets)
+            w->draw_count = 0u;
+
+        nvgBeginFrame(vg, list.width(), list.height(), 1.f);
+        list.draw(vg);
+        nvgCancelFrame(vg);
+
+        for (auto *w : model.widgets) {
+            const auto top = w->pos_y();
+            const auto bottom = top + w->height();
+
+            if (w->draw_count > 1u || (w->draw_count == 1u && (bottom <= 0.f || top >= list_height))) {
+                std::cerr << "Columns " << column_count << " : item " << w->item << " drawn while not displayed" << std::endl;
+                failure_count++;
+            }
+        }
+    }
+
+    if (model.widgets.size() > max_widget_count) {
+        std::cerr << "Columns " << column_count << " : " << model.widgets.size() << " item widgets created" << std::endl;
+        failure_count++;
+    }
+
+    //  Scrolling by a row only bind the new items
+    list.scroll_to_item(item_count / 3u);
+    model.bind_count = 0u;
+    list.scroll_to(list.scroll_offset() + model.row_height((item_count / 3u) / column_count));
+
+    if (model.bind_count > 2u * column_count) {
+        std::cerr << "Columns " << column_count << " : " << model.bind_count << " items bound when scrolling by one row" << std::endl;
+        failure_count++;
+    }
+
+    if (failure_count == 0)
+        std::cout << "virtual_list : " << column_count << " columns, " << model.widgets.size() << " widgets for " << item_count << " items" << std::endl;
+
+    return failure_count;
+}
+
+int main()
+{
+    auto *vg = create_null_context();
+    int failure_count = check_row_offset_index();
+
+    failure_count += check_list(vg, 1u);
+    failure_count += check_list(vg, 4u);
+
+    nvgDeleteInternal(vg);
+    return failure_count == 0 ? 0 : 1;
+}
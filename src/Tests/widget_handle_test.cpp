@@ -0,0 +1,173 @@
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "view.h"
+#include "test_check.h"
+
+/**
+ *  Check that the widget handles resolve to null once their widget is destroyed, even when its
+ *  slot is reused, and that a widget_proxy keep a shared child alive while forwarding an input
+ *  event to it, so that the child can replace itself from its own event handler, but does not
+ *  lock it to draw it nor to forward the mouse moves.
+ */
+
+//  A page with a button that replace the page when clicked
+class page : public View::widget, public std::enable_shared_from_this<page> {
+public:
+    page()
+    :   View::widget{100.f, 100.f}
+    {}
+
+    ~page() override
+    {
+        if (_in_event_handler)
+            destroyed_in_event_handler = true;
+    }
+
+    void draw(NVGcontext*) override { _record_owners(); }
+    void draw_rect(NVGcontext*, const View::rectangle<>&) override { _record_owners(); }
+
+    View::rectangle<> opaque_rect() const override
+    {
+        _record_owners();
+        return {};
+    }
+
+    bool on_mouse_move(float, float) override
+    {
+        _record_owners();
+        return true;
+    }
+
+    bool on_mouse_button_down(const View::mouse_button, float, float) override
+    {
+        _record_owners();
+        _in_event_handler = true;
+        on_click();
+        click_count++;          //  The page is still used after the callback
+        _in_event_handler = false;
+        return true;
+    }
+
+    std::function<void()> on_click{[]() {}};
+    unsigned int click_count{0u};
+    mutable long owner_count{0};    //  Owners of the page during the last forwarded call
+    static inline bool destroyed_in_event_handler{false};
+
+private:
+    void _record_owners() const
+    {
+        owner_count = weak_from_this().use_count();
+    }
+
+    bool _in_event_handler{false};
+};
+
+static void check_handles()
+{
+    View::widget_handle<> first_handle{};
+
+    check(!first_handle, "A default handle is not null");
+
+    {
+        auto w = std::make_unique<View::widget>(10.f, 10.f);
+        first_handle = View::widget_handle<>{*w};
+        check(first_handle.get() == w.get(), "A handle does not resolve to its widget");
+        check(first_handle == View::widget_handle<>{*w}, "Two handles to the same widget differ");
+    }
+
+    check(!first_handle, "A handle to a destroyed widget is not null");
+
+    //  The released slots are reused : the old handle must stay null
+    for (auto i = 0u; i < 16u; ++i) {
+        auto w = std::make_unique<View::widget>(10.f, 10.f);
+        View::widget_handle<> handle{*w};
+
+        check(handle.get() == w.get(), "A handle to a reused slot does not resolve to its widget");
+        check(!first_handle, "A handle resolve to a widget that reused the slot of its destroyed widget");
+        check(!(handle == first_handle), "A handle equal a handle to a destroyed widget");
+    }
+
+    //  A moved widget is a new widget
+    View::widget source{10.f, 10.f};
+    View::widget_handle<> source_handle{source};
+    View::widget moved{std::move(source)};
+
+    check(source_handle.get() == &source, "Moving a widget changed the handles to the source");
+    check(View::widget_handle<>{moved}.get() == &moved, "A handle to a moved widget does not resolve to it");
+}
+
+static void check_proxy_self_replace()
+{
+    View::widget_proxy<> proxy{100.f, 100.f};
+    std::shared_ptr<page> current_page{};
+    unsigned int page_count = 0u;
+
+    std::function<void()> show_new_page =
+        [&]()
+        {
+            auto next = std::make_shared<page>();
+            next->on_click = show_new_page;
+            page_count++;
+
+            //  Release the current page while its event handler is running
+            current_page = next;
+            proxy.set_widget(std::weak_ptr<page>{current_page});
+        };
+
+    show_new_page();
+
+    for (auto i = 0u; i < 4u; ++i)
+        proxy.on_mouse_button_down(View::mouse_button::left, 10.f, 10.f);
+
+    check(!page::destroyed_in_event_handler, "A proxied page was destroyed while its event handler was running");
+    check(page_count == 5u, "The proxied page was not replaced on each click");
+    check(current_page->click_count == 0u, "The events were not forwarded to the new page");
+
+    //  The proxy is empty once its child is destroyed
+    current_page.reset();
+    check(!proxy.on_mouse_button_down(View::mouse_button::left, 10.f, 10.f), "A proxy forwarded an event to a destroyed child");
+}
+
+//  Only the owner hold the page while it is drawn or receive a mouse move
+static void check_proxy_hot_paths()
+{
+    View::widget_proxy<> proxy{100.f, 100.f};
+    auto shared_page = std::make_shared<page>();
+    auto& p = *shared_page;
+    proxy.set_widget(std::weak_ptr<page>{shared_page});
+
+    proxy.draw(nullptr);
+    check(p.owner_count == 1, "A proxy locked its shared child to draw it");
+
+    proxy.draw_rect(nullptr, View::make_rectangle(0.f, 10.f, 0.f, 10.f));
+    check(p.owner_count == 1, "A proxy locked its shared child to draw a part of it");
+
+    proxy.opaque_rect();
+    check(p.owner_count == 1, "A proxy locked its shared child to get its opaque area");
+
+    proxy.on_mouse_move(10.f, 10.f);
+    check(p.owner_count == 1, "A proxy locked its shared child to forward a mouse move");
+
+    proxy.on_mouse_button_down(View::mouse_button::left, 10.f, 10.f);
+    check(p.owner_count == 2, "A proxy did not keep its shared child alive while forwarding a click");
+
+    //  The hot paths see the destroyed child through its handle
+    shared_page.reset();
+    check(!proxy.on_mouse_move(10.f, 10.f), "A proxy forwarded a mouse move to a destroyed child");
+    proxy.draw(nullptr);
+}
+
+int main()
+{
+    check_handles();
+    check_proxy_self_replace();
+    check_proxy_hot_paths();
+
+    if (failure_count == 0)
+        std::cout << "widget_handle : handles and proxies do not reach destroyed widgets" << std::endl;
+
+    return failure_count == 0 ? 0 : 1;
+}
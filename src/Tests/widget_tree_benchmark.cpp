@@ -0,0 +1,168 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "view.h"
+#include "null_context.h"
+#include "helpers/layout_builder.h"
+#include "display/common/display_controler.h"
+
+/**
+ *  Compare the traversal time of a widget tree allocated on the heap and in a widget_arena.
+ *  The tree is built while unrelated blocks are allocated and released, as in an application
+ *  which load its content while building its interface, so that the heap allocated widgets
+ *  are spread in memory. The widgets are drawn with a NanoVG context that discard the drawing
+ *  commands, so that only the traversal is measured.
+ */
+
+constexpr auto row_count = 25u;
+constexpr auto column_count = 50u;
+constexpr auto cell_width = 20.f;
+constexpr auto cell_height = 16.f;
+constexpr auto frame_count = 200u;
+constexpr auto mouse_move_count = 20000u;
+
+class leaf_widget : public View::widget {
+public:
+    leaf_widget()
+    :   View::widget{cell_width, cell_height}
+    {}
+
+    void draw(NVGcontext*) override { draw_count++; }
+
+    bool on_mouse_move(float, float) override
+    {
+        move_count++;
+        return false;
+    }
+
+    unsigned int draw_count{0u};
+    unsigned int move_count{0u};
+};
+
+class null_display : public View::display_controler {
+public:
+    explicit null_display(View::widget& root)
+    :   View::display_controler{root}
+    {}
+
+    void invalidate_rect(const View::rectangle<>&) override {}
+    void set_cursor(View::cursor) override {}
+};
+
+//  Unrelated allocations made while the tree is built
+class heap_noise {
+public:
+    void allocate()
+    {
+        _blocks.push_back(std::make_unique<char[]>(_size(_random)));
+        if (_blocks.size() % 2u == 0u)
+            _blocks[_random() % _blocks.size()].reset();
+    }
+
+private:
+    std::mt19937 _random{42u};
+    std::uniform_int_distribution<std::size_t> _size{16u, 512u};
+    std::vector<std::unique_ptr<char[]>> _blocks{};
+};
+
+template <View::orientation O, typename TMakeChild>
+static std::unique_ptr<View::widget> make_balanced_layout(unsigned int begin, unsigned int end, TMakeChild& make_child)
+{
+    if (end - begin == 1u)
+        return make_child(begin);
+
+    const auto middle = begin + (end - begin) / 2u;
+    auto first = make_balanced_layout<O>(begin, middle, make_child);
+    auto second = make_balanced_layout<O>(middle, end, make_child);
+    return std::make_unique<View::pair_layout<O>>(std::move(first), std::move(second));
+}
+
+static std::unique_ptr<View::widget> make_tree(
+    View::widget_arena *arena, heap_noise& noise, std::vector<leaf_widget*>& leaves)
+{
+    View::layout_builder builder{3.f, 3.f, arena};
+    View::widget_arena::scope scope{arena};
+
+    auto make_cell =
+        [&](unsigned int)
+        {
+            noise.allocate();
+            auto leaf = std::make_unique<leaf_widget>();
+            leaves.push_back(leaf.get());
+            return std::make_unique<View::border_wrapper>(std::move(leaf), 1.f, 1.f, 1.f, 1.f);
+        };
+
+    auto make_row =
+        [&](unsigned int)
+        {
+            return builder.header(
+                make_balanced_layout<View::orientation::horizontal>(0u, column_count, make_cell));
+        };
+
+    return builder.windows(
+        make_balanced_layout<View::orientation::vertical>(0u, row_count, make_row));
+}
+
+static void benchmark(const char *name, View::widget_arena *arena, heap_noise& noise, NVGcontext *vg)
+{
+    using clock = std::chrono::steady_clock;
+    using milliseconds = std::chrono::duration<double, std::milli>;
+
+    std::vector<leaf_widget*> leaves{};
+    auto root = make_tree(arena, noise, leaves);
+    null_display display{*root};
+
+    //  Draw traversal
+    const auto draw_start = clock::now();
+
+    for (auto i = 0u; i < frame_count; ++i) {
+        nvgBeginFrame(vg, root->width(), root->height(), 1.f);
+        root->draw(vg);
+        nvgCancelFrame(vg);
+    }
+
+    const auto draw_time = milliseconds{clock::now() - draw_start}.count() / frame_count;
+
+    //  Event traversal, sweeping the whole tree
+    std::mt19937 random{7u};
+    std::uniform_real_distribution<float> x{0.f, root->width()};
+    std::uniform_real_distribution<float> y{0.f, root->height()};
+    const auto move_start = clock::now();
+
+    for (auto i = 0u; i < mouse_move_count; ++i)
+        root->on_mouse_move(x(random), y(random));
+
+    const auto move_time = milliseconds{clock::now() - move_start}.count() * 1000.0 / mouse_move_count;
+
+    unsigned int draw_count = 0u;
+    for (const auto *leaf : leaves)
+        draw_count += leaf->draw_count;
+
+    std::cout << name << " : ";
+    if (arena != nullptr)
+        std::cout << arena->widget_count() << " widgets (" << arena->allocated_size() / 1024u << " KiB), ";
+    std::cout
+        << draw_time << " ms per draw (" << draw_count / frame_count << " leaves), "
+        << move_time << " us per mouse move" << std::endl;
+}
+
+int main()
+{
+    auto *vg = create_null_context();
+
+    {
+        heap_noise noise{};
+        benchmark("Heap ", nullptr, noise, vg);
+    }
+
+    {
+        heap_noise noise{};
+        View::widget_arena arena{};
+        benchmark("Arena", &arena, noise, vg);
+    }
+
+    nvgDeleteInternal(vg);
+    return 0;
+}
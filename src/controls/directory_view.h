@@ -4,8 +4,10 @@
 #include <vector>
 #include <set>
 #include <cmath>
+#include <string>
 #include "helpers/directory_model.h"
 #include "control.h"
+#include "drawing/glyph_warmup.h"
 #include "drawing/text_helper.h"
 
 namespace View {
@@ -270,6 +272,16 @@ namespace View {
         for (auto& node : _model)
             add_cells(node.first, node.second, 0);
 
+        //  Rasterize the captions glyphs before they are scrolled into view
+        std::string captions{};
+        std::string directory_captions{};
+
+        for (const auto& c : _cells)
+            (c.type == cell_type::directory ? directory_captions : captions) += c.caption;
+
+        glyph_warmup::post(captions, 0, _font_size);
+        glyph_warmup::post(directory_captions, 1, _font_size);
+
         invalidate();
     }
 
@@ -0,0 +1,469 @@
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include "offscreen_backend.h"
+
+#include "display/common/widget_adapter.h"
+#include "display/common/damage_region.h"
+#include "display/common/gl_framebuffer.h"
+#include "display/common/gl_renderer.h"
+#include "internal_fonts/internal_fonts.h"
+
+namespace View {
+
+    class offscreen_surface : private widget_adapter {
+    public:
+        offscreen_surface(widget& root, float pixel_per_unit, frame_scheduler& scheduler, input_latency_tracker& latency, gl_version renderer);
+        offscreen_surface(const offscreen_surface&) = delete;
+        ~offscreen_surface();
+
+        void resize(unsigned int width, unsigned int height);
+        bool render();
+        void render_all();
+        std::vector<std::uint8_t> read_pixels();
+
+        //  display controller interface
+        void set_cursor(cursor c) override;
+        cursor current_cursor() const noexcept { return _cursor; }
+        gl_version renderer() const noexcept { return _renderer; }
+
+        using widget_adapter::display_width;
+        using widget_adapter::display_height;
+
+        using widget_adapter::sys_mouse_move;
+        using widget_adapter::sys_mouse_enter;
+        using widget_adapter::sys_mouse_exit;
+        using widget_adapter::sys_mouse_button_down;
+        using widget_adapter::sys_mouse_button_up;
+        using widget_adapter::sys_mouse_wheel;
+        using widget_adapter::sys_mouse_dbl_click;
+        using widget_adapter::sys_char_input;
+
+    private:
+        //  Widget adapter interface
+        void sys_invalidate_rect(const draw_area& area) override;
+
+        //  Internal helpers
+        void _open_egl_display();
+        void _create_egl_context(EGLConfig config);
+        void _make_current();
+        void _draw_region(const damage_region& region);
+
+        //  EGL members
+        EGLDisplay _egl_display{EGL_NO_DISPLAY};
+        EGLContext _egl_context{EGL_NO_CONTEXT};
+
+        //  Offscreen framebuffer
+        gl_framebuffer _framebuffer{};
+
+        //  Drawing context
+        gl_version _renderer;
+        NVGcontext *_vg{nullptr};
+        frame_scheduler& _scheduler;
+        input_latency_tracker& _latency;
+
+        damage_region _damage{};
+        cursor _cursor{cursor::standard};
+    };
+
+    offscreen_surface::offscreen_surface(widget& root, float pixel_per_unit, frame_scheduler& scheduler, input_latency_tracker& latency, gl_version renderer)
+    :   widget_adapter{root, pixel_per_unit},
+        _renderer{renderer},
+        _scheduler{scheduler},
+        _latency{latency}
+    {
+        _open_egl_display();
+
+        const EGLint config_attributes[] = {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8,
+            EGL_GREEN_SIZE, 8,
+            EGL_BLUE_SIZE, 8,
+            EGL_ALPHA_SIZE, 8,
+            EGL_NONE
+        };
+
+        EGLConfig config;
+        EGLint config_count = 0;
+
+        if (!eglChooseConfig(_egl_display, config_attributes, &config, 1, &config_count) || config_count == 0)
+            throw std::runtime_error("offscreen_backend : unable to find an EGL config");
+
+        if (!eglBindAPI(EGL_OPENGL_API))
+            throw std::runtime_error("offscreen_backend : OpenGL is not supported by EGL");
+
+        _create_egl_context(config);
+
+        //  No surface is needed : everything is drawn in our own framebuffer
+        _make_current();
+
+        //  Glew + OpenGL
+        glewExperimental = GL_TRUE;     //  Needed by glew with a core profile
+        glewInit();
+        if (!_framebuffer.resize(display_width(), display_height()))
+            throw std::runtime_error("offscreen_backend : unable to create the framebuffer");
+
+        //  NanoVG
+        _vg = create_nanovg_gl_context(_renderer);
+
+        //  Intitialize internals fonts
+        create_roboto_regular_font(_vg);
+        create_roboto_bold_font(_vg);
+        sys_prerender_glyphs(_vg);
+
+        //  Initial drawing
+        render_all();
+    }
+
+    offscreen_surface::~offscreen_surface()
+    {
+        _make_current();
+        delete_nanovg_gl_context(_vg, _renderer);
+        _framebuffer.release();
+        eglMakeCurrent(_egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(_egl_display, _egl_context);
+        //  The EGL display is shared by the whole process : it is not terminated here
+    }
+
+    void offscreen_surface::resize(unsigned int width, unsigned int height)
+    {
+        _make_current();
+
+        //  Notify the content that the surface size has changed
+        resize_display(width, height);
+
+        //  Content must be entirely redrawn in the new framebuffer. Nothing is drawn while the size is 0
+        if (!_framebuffer.resize(width, height))
+            throw std::runtime_error("offscreen_backend : unable to resize the framebuffer");
+
+        render_all();
+    }
+
+    bool offscreen_surface::render()
+    {
+        const auto surface_area = make_rectangle(0, display_height(), 0, display_width());
+        damage_region drawing_region{};
+
+        for (const auto& area : _damage) {
+            draw_area drawing_area;
+            if (area.intersect(surface_area, drawing_area))
+                drawing_region.add(drawing_area);
+        }
+
+        _damage.clear();
+
+        if (drawing_region.empty())
+            return false;
+
+        _make_current();
+        _draw_region(drawing_region);
+        return true;
+    }
+
+    void offscreen_surface::render_all()
+    {
+        damage_region whole_surface{};
+        whole_surface.add(make_rectangle(0, display_height(), 0, display_width()));
+
+        _make_current();
+        _draw_region(whole_surface);
+        _damage.clear();
+    }
+
+    std::vector<std::uint8_t> offscreen_surface::read_pixels()
+    {
+        const auto width = display_width();
+        const auto height = display_height();
+        const auto row_size = 4u * width;
+        std::vector<std::uint8_t> pixels(row_size * height);
+
+        if (_framebuffer.empty())
+            return pixels;
+
+        _make_current();
+        _framebuffer.read_pixels(pixels.data());
+
+        //  OpenGL rows are ordered from bottom to top
+        for (auto row = 0u; row < height / 2u; ++row) {
+            std::swap_ranges(
+                pixels.begin() + row * row_size,
+                pixels.begin() + (row + 1u) * row_size,
+                pixels.begin() + (height - row - 1u) * row_size);
+        }
+
+        return pixels;
+    }
+
+    void offscreen_surface::set_cursor(cursor c)
+    {
+        _cursor = c;
+    }
+
+    void offscreen_surface::sys_invalidate_rect(const draw_area& area)
+    {
+        _damage.add(area);
+    }
+
+    void offscreen_surface::_open_egl_display()
+    {
+        //  Prefer the Mesa surfaceless platform : it works without any X server or GPU (llvmpipe)
+        const auto get_platform_display =
+            reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+                eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+        if (get_platform_display != nullptr) {
+            _egl_display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (_egl_display != EGL_NO_DISPLAY && eglInitialize(_egl_display, nullptr, nullptr))
+                return;
+        }
+
+        //  Fallback on the default platform
+        _egl_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+        if (_egl_display == EGL_NO_DISPLAY || !eglInitialize(_egl_display, nullptr, nullptr))
+            throw std::runtime_error("offscreen_backend : unable to open an EGL display");
+    }
+
+    void offscreen_surface::_create_egl_context(EGLConfig config)
+    {
+        if (_renderer == gl_version::gl3 && gl_renderer_available(gl_version::gl3)) {
+            const EGLint context_attributes[] = {
+                EGL_CONTEXT_MAJOR_VERSION, 3,
+                EGL_CONTEXT_MINOR_VERSION, 2,
+                EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                EGL_NONE
+            };
+
+            _egl_context = eglCreateContext(_egl_display, config, EGL_NO_CONTEXT, context_attributes);
+
+            if (_egl_context != EGL_NO_CONTEXT)
+                return;
+        }
+
+        //  Compatibility context : use the OpenGL 2 renderer
+        _renderer = gl_version::gl2;
+        _egl_context = eglCreateContext(_egl_display, config, EGL_NO_CONTEXT, nullptr);
+
+        if (_egl_context == EGL_NO_CONTEXT)
+            throw std::runtime_error("offscreen_backend : unable to create an EGL context");
+    }
+
+    void offscreen_surface::_make_current()
+    {
+        eglMakeCurrent(_egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, _egl_context);
+    }
+
+    void offscreen_surface::_draw_region(const damage_region& region)
+    {
+        const auto width = display_width();
+        const auto height = display_height();
+
+        if (region.empty() || _framebuffer.empty())
+            return;
+
+        _scheduler.begin_frame();
+        _framebuffer.bind();
+
+        //  The framebuffer content is kept between frames : only clear the redrawn areas
+        glEnable(GL_SCISSOR_TEST);
+        for (const auto& area : region) {
+            glScissor(area.left, height - area.bottom, area.width(), area.height());
+            glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+        }
+        glDisable(GL_SCISSOR_TEST);
+
+        nvgBeginFrame(_vg, width, height, 1.);
+
+        for (const auto& area : region) {
+            nvgSave(_vg);
+
+            //  Do not draw outside the cleared area
+            nvgScissor(_vg, area.left, area.top, area.width(), area.height());
+            sys_draw_rect(_vg, area.top, area.bottom, area.left, area.right);
+
+            nvgRestore(_vg);
+        }
+
+        nvgEndFrame(_vg);
+        sys_update_layers(_vg);
+        gl_framebuffer::bind_default();
+        _scheduler.end_draw();
+        _latency.end_draw();
+
+        glFinish();
+        _scheduler.end_frame();
+        _latency.end_frame();
+
+        //  Rasterize a slice of the glyphs posted for the next frames
+        sys_warmup_glyphs(_vg);
+    }
+
+    /**
+     *
+     *      offscreen_backend implementation
+     *
+     */
+    offscreen_backend::offscreen_backend(widget& root, float pixel_per_unit, gl_version renderer)
+    : view_backend{root, pixel_per_unit}, _renderer{renderer}
+    {
+    }
+
+    offscreen_backend::~offscreen_backend() = default;
+
+    void offscreen_backend::create_window(const std::string&, void *)
+    {
+        if (!_surface)
+            _surface = std::make_unique<offscreen_surface>(_root, _pixel_per_unit, _scheduler, _latency, _renderer);
+    }
+
+    void offscreen_backend::wait_window_thread()
+    {
+        //  There is no window thread : the surface is driven by the caller
+    }
+
+    void offscreen_backend::close_window()
+    {
+        _surface.reset();
+    }
+
+    bool offscreen_backend::windows_is_open() const noexcept
+    {
+        return static_cast<bool>(_surface);
+    }
+
+    void offscreen_backend::post_to_ui_thread(std::function<void()> task)
+    {
+        _ui_queue.post_task(std::move(task));
+    }
+
+    frame_statistics offscreen_backend::get_frame_statistics() const
+    {
+        return _scheduler.statistics();
+    }
+
+    input_latency_statistics offscreen_backend::get_input_latency_statistics() const
+    {
+        return _latency.statistics();
+    }
+
+    void offscreen_backend::resize(unsigned int width, unsigned int height)
+    {
+        if (_surface)
+            _surface->resize(width, height);
+    }
+
+    bool offscreen_backend::render()
+    {
+        if (_surface) {
+            _ui_queue.run_tasks();
+
+            if (_surface->render())
+                return true;
+
+            //  The events injected since the last frame had no visible effect
+            _latency.discard_pending();
+            return false;
+        }
+        else {
+            return false;
+        }
+    }
+
+    void offscreen_backend::render_all()
+    {
+        if (_surface) {
+            _ui_queue.run_tasks();
+            _surface->render_all();
+        }
+    }
+
+    std::vector<std::uint8_t> offscreen_backend::read_pixels() const
+    {
+        if (_surface)
+            return _surface->read_pixels();
+        else
+            return {};
+    }
+
+    gl_version offscreen_backend::renderer() const noexcept
+    {
+        return _surface ? _surface->renderer() : _renderer;
+    }
+
+    unsigned int offscreen_backend::surface_width() const noexcept
+    {
+        return _surface ? _surface->display_width() : 0u;
+    }
+
+    unsigned int offscreen_backend::surface_height() const noexcept
+    {
+        return _surface ? _surface->display_height() : 0u;
+    }
+
+    cursor offscreen_backend::current_cursor() const noexcept
+    {
+        return _surface ? _surface->current_cursor() : cursor::standard;
+    }
+
+    template <typename TEvent>
+    bool offscreen_backend::_inject(TEvent&& event)
+    {
+        if (!_surface)
+            return false;
+
+        _latency.begin_event(input_latency_tracker::clock::now());
+        const auto ret = event(*_surface);
+        _latency.end_event();
+
+        return ret;
+    }
+
+    bool offscreen_backend::mouse_move(unsigned int x, unsigned int y)
+    {
+        return _inject([&](offscreen_surface& s) { return s.sys_mouse_move(x, y); });
+    }
+
+    bool offscreen_backend::mouse_enter()
+    {
+        return _inject([&](offscreen_surface& s) { return s.sys_mouse_enter(); });
+    }
+
+    bool offscreen_backend::mouse_exit()
+    {
+        return _inject([&](offscreen_surface& s) { return s.sys_mouse_exit(); });
+    }
+
+    bool offscreen_backend::mouse_button_down(mouse_button button)
+    {
+        return _inject([&](offscreen_surface& s) { return s.sys_mouse_button_down(button); });
+    }
+
+    bool offscreen_backend::mouse_button_up(mouse_button button)
+    {
+        return _inject([&](offscreen_surface& s) { return s.sys_mouse_button_up(button); });
+    }
+
+    bool offscreen_backend::mouse_wheel(float distance)
+    {
+        return _inject([&](offscreen_surface& s) { return s.sys_mouse_wheel(distance); });
+    }
+
+    bool offscreen_backend::mouse_dbl_click()
+    {
+        return _inject([&](offscreen_surface& s) { return s.sys_mouse_dbl_click(); });
+    }
+
+    bool offscreen_backend::char_input(char c)
+    {
+        return _inject([&](offscreen_surface& s) { return s.sys_char_input(c); });
+    }
+}
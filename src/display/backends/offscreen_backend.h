@@ -0,0 +1,116 @@
+#ifndef VIEW_OFFSCREEN_BACKEND_H_
+#define VIEW_OFFSCREEN_BACKEND_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "view_backend.h"
+#include "display/common/gl_renderer.h"
+#include "display/common/ui_task_queue.h"
+
+namespace View {
+
+    class offscreen_surface;
+
+    /**
+     *  \class offscreen_backend
+     *  \brief Render the widget tree into an offscreen framebuffer, without any window
+     *  \details The surface is driven by the calling thread : there is no event thread.
+     *  create_window, the event injection methods, render and read_pixels must all be
+     *  called from the same thread, which own the underlying OpenGL context.
+     *  Coordinates are given in pixel, as with an on screen window.
+     */
+    class offscreen_backend : public view_backend {
+
+    public:
+        /**
+         *  \param renderer requested NanoVG renderer : fallback on OpenGL 2 if a core profile is not available
+         */
+        offscreen_backend(widget& root, float pixel_per_unit, gl_version renderer = gl_version::gl2);
+        ~offscreen_backend() override;
+
+        /**
+         *  \brief Create the offscreen surface (title and parent are ignored)
+         */
+        void create_window(const std::string& title, void *parent = nullptr) override;
+        void wait_window_thread() override;
+        void close_window() override;
+        bool windows_is_open() const noexcept override;
+
+        /**
+         *  \brief Post a closure, executed by the next call to render or render_all
+         */
+        void post_to_ui_thread(std::function<void()> task) override;
+
+        /**
+         *  \brief Timing of the render calls (swap time is the time spent waiting for the GPU)
+         */
+        frame_statistics get_frame_statistics() const override;
+
+        /**
+         *  \brief Latency of the injected events, from their injection to the render call that presented them
+         */
+        input_latency_statistics get_input_latency_statistics() const override;
+
+        /**
+         *  \brief Resize the offscreen surface
+         */
+        void resize(unsigned int width, unsigned int height);
+
+        /**
+         *  \brief Execute the posted closures and redraw the area invalidated since the last render
+         *  \return true if something was drawn
+         */
+        bool render();
+
+        /**
+         *  \brief Redraw the whole widget tree
+         */
+        void render_all();
+
+        /**
+         *  \brief Read back the framebuffer content
+         *  \return RGBA pixels, 4 bytes per pixel, rows ordered from top to bottom
+         */
+        std::vector<std::uint8_t> read_pixels() const;
+
+        /**
+         *  \brief Return the NanoVG renderer actually used by the surface
+         */
+        gl_version renderer() const noexcept;
+
+        unsigned int surface_width() const noexcept;
+        unsigned int surface_height() const noexcept;
+
+        /**
+         *  \brief Return the cursor last requested by the widgets
+         */
+        cursor current_cursor() const noexcept;
+
+        /**
+         *  Event injection : same semantic than the events received from a window
+         */
+        bool mouse_move(unsigned int x, unsigned int y);
+        bool mouse_enter();
+        bool mouse_exit();
+        bool mouse_button_down(mouse_button button);
+        bool mouse_button_up(mouse_button button);
+        bool mouse_wheel(float distance);
+        bool mouse_dbl_click();
+        bool char_input(char c);
+
+    private:
+        template <typename TEvent>
+        bool _inject(TEvent&& event);
+
+        const gl_version _renderer;
+        std::unique_ptr<offscreen_surface> _surface{};
+        ui_task_queue _ui_queue{};
+        frame_scheduler _scheduler{};
+        input_latency_tracker _latency{};
+    };
+
+}
+
+#endif
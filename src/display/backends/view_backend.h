@@ -1,8 +1,11 @@
 #ifndef VIEW_BACKEND_H_
 #define VIEW_BACKEND_H_
 
+#include <functional>
 #include <string>
 #include "widget/widget.h"
+#include "display/common/frame_scheduler.h"
+#include "display/common/input_latency.h"
 
 namespace View
 {
@@ -21,6 +24,36 @@ namespace View
         virtual void close_window() = 0;
         virtual bool windows_is_open() const noexcept = 0;
 
+        /**
+         *  \brief Execute a closure on the thread that handle the window events and drawing
+         *  \details Can be called from any thread, without locking, but the closure is allocated :
+         *  not from a real time thread. The closure is executed as soon as possible, before the
+         *  next frame is drawn. Closures posted while no window is open are executed once a window is opened.
+         */
+        virtual void post_to_ui_thread(std::function<void()> task) = 0;
+
+        /**
+         *  \brief Frame pacing : ignored by the backends that do not control their frame rate
+         */
+        virtual void set_vsync(vsync_mode) {}
+        virtual void set_max_fps(float) {}
+
+        /**
+         *  \brief Deliver only the last mouse position of each frame (default), or every position
+         *  \note Ignored by the backends that deliver mouse moves as they are received
+         */
+        virtual void set_motion_compression(bool) {}
+
+        /**
+         *  \brief Return the frame timings measured since the window was opened
+         */
+        virtual frame_statistics get_frame_statistics() const { return {}; }
+
+        /**
+         *  \brief Return the latency of the input events presented since the window was opened
+         */
+        virtual input_latency_statistics get_input_latency_statistics() const { return {}; }
+
         /**
          *  \brief Used to receive keyboard text input from VST2 Host
          *  \note This should not be implemented if keyboard event can be retrieved by the vst2 plugin
@@ -8,24 +8,27 @@
 #include <GL/glew.h>
 #include <GL/gl.h>
 #include <array>
-
-#include "nanovg.h"
-#include "nanovg_gl.h"
+#include <iostream>
 
 #include "win32_backend.h"
 
 #include "display/common/display_controler.h"
 #include "display/common/widget_adapter.h"
+#include "display/common/gl_framebuffer.h"
+#include "display/common/gl_renderer.h"
 #include "internal_fonts/internal_fonts.h"
 
 #define WINDOW_VIEW_CLASS_NAME "ViewWindow"
 
+//  Posted to the window to execute the closures pending in the ui task queue
+#define WM_VIEW_RUN_UI_TASKS (WM_APP + 1)
+
 namespace View {
 
     class win32_window : private widget_adapter {
     public:
         win32_window(
-            widget& root, float pixel_per_unit,
+            widget& root, float pixel_per_unit, ui_task_queue& ui_queue,
             const std::string& title, HWND parent = 0);
         win32_window(const win32_window&) = delete;
         ~win32_window();
@@ -35,6 +38,8 @@ namespace View {
         // display controller interface
         void set_cursor(cursor c) override;
 
+        HWND native_handle() const noexcept { return _window; }
+
         using widget_adapter::sys_char_input;
     private:
         //  Widget adapter interface
@@ -55,9 +60,12 @@ namespace View {
             LPARAM l_param);
 
         // Drawing context
-        NVGcontext* _vg;
+        NVGcontext* _vg{nullptr};
         HGLRC _opengl_context{};
 
+        //  Window content is kept here between frames : only the painted area is redrawn
+        gl_framebuffer _framebuffer{};
+
         // Win32 members
         cursor _current_cursor{cursor::standard};
         std::array<HCURSOR, VIEW_CURSOR_COUNT> _win32_cursors{};
@@ -65,15 +73,18 @@ namespace View {
         HWND _window{0};
         bool _has_focus{false};
 
+        ui_task_queue& _ui_queue;
+
     };
 
     /**
      * in32 window implementation
      */
 
-    win32_window::win32_window(widget& root, float pixel_per_unit, const std::string& title, HWND parent)
+    win32_window::win32_window(widget& root, float pixel_per_unit, ui_task_queue& ui_queue, const std::string& title, HWND parent)
     :   widget_adapter{root, pixel_per_unit},
-        _parent{parent}
+        _parent{parent},
+        _ui_queue{ui_queue}
     {
         DWORD window_style = WS_VISIBLE;
         const auto window_width = display_width();
@@ -142,12 +153,17 @@ namespace View {
         glEnable(GL_STENCIL_TEST);
         glClearColor(0.0, 0.0, 0.0, 1.0);
 
+        //  Offscreen copy of the window content
+        if (!_framebuffer.resize(display_width(), display_height()))
+            throw std::runtime_error("win32_backend : unable to create the framebuffer");
+
         //  NanoVG
-        _vg = nvgCreateGL2(NVG_ANTIALIAS | NVG_STENCIL_STROKES | NVG_DEBUG);
+        _vg = create_nanovg_gl_context();
 
         //  Intitialize internals fonts and cursors
         create_roboto_regular_font(_vg);
         create_roboto_bold_font(_vg);
+        sys_prerender_glyphs(_vg);
 
         _initialize_cursors();
         _apply_cursor();
@@ -157,6 +173,8 @@ namespace View {
 
     win32_window::~win32_window()
     {
+        _framebuffer.release();
+        delete_nanovg_gl_context(_vg);
         wglMakeCurrent(NULL, NULL);
         wglDeleteContext(_opengl_context);
         DestroyWindow(_window);
@@ -215,16 +233,32 @@ namespace View {
             paint_struct.rcPaint.left,
             paint_struct.rcPaint.right };
 
+        //  Nothing is drawn nor presented while the window has no size (minimized)
         draw_area drawing_area;
-        if (rc_paint.intersect(window_area, drawing_area)) {
+        if (!_framebuffer.empty() && rc_paint.intersect(window_area, drawing_area)) {
+            _framebuffer.bind();
+
+            //  The framebuffer content is kept between frames : only clear the redrawn area
+            glEnable(GL_SCISSOR_TEST);
+            glScissor(drawing_area.left, display_height() - drawing_area.bottom, drawing_area.width(), drawing_area.height());
             glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+            glDisable(GL_SCISSOR_TEST);
+
             nvgBeginFrame(_vg, display_width(), display_height(), 1.);
+            nvgScissor(_vg, drawing_area.left, drawing_area.top, drawing_area.width(), drawing_area.height());
 
             sys_draw_rect(_vg, drawing_area.top, drawing_area.bottom, drawing_area.left, drawing_area.right);
 
             nvgEndFrame(_vg);
+            sys_update_layers(_vg);
+
+            //  The back buffer content is undefined after a swap : refresh it entirely
+            _framebuffer.blit_to_default();
             glFlush();
             SwapBuffers(paint_struct.hdc);
+
+            //  Rasterize a slice of the glyphs posted for the next frames
+            sys_warmup_glyphs(_vg);
         }
 
         EndPaint(_window, &paint_struct);
@@ -234,8 +268,16 @@ namespace View {
     {
         //  Notify the content that window size has changed
         resize_display(width, height);
-        //  Update drawing context
-        glViewport(0, 0, width, height);
+
+        //  Update drawing context (not yet created during window creation)
+        //  Called from the window procedure : a failure must not throw through the host event loop
+        if (_vg != nullptr) {
+            if (!_framebuffer.resize(width, height))
+                std::cerr << "win32_backend : unable to allocate a " << width << "x" << height << " framebuffer" << std::endl;
+
+            glViewport(0, 0, width, height);
+            InvalidateRect(_window, nullptr, false);
+        }
     }
 
     void win32_window::_initialize_cursors()
@@ -308,6 +350,10 @@ namespace View {
             window_instance->_resize_content(LOWORD(l_param), HIWORD(l_param));
             break;
 
+        case WM_VIEW_RUN_UI_TASKS:
+            window_instance->_ui_queue.run_tasks();
+            break;
+
         case WM_MOVE:
             InvalidateRect(window_instance->_window, NULL, TRUE);
             break;
@@ -412,7 +458,8 @@ namespace View {
             else {
                 // children window : event are manager by parent
                 _window = std::make_unique<win32_window>(
-                    _root, _pixel_per_unit, title, reinterpret_cast<HWND>(parent));
+                    _root, _pixel_per_unit, _ui_queue, title, reinterpret_cast<HWND>(parent));
+                _publish_window();
             }
         }
     }
@@ -434,6 +481,7 @@ namespace View {
             }
             else {
                 // there is no event manager, so we must delete the window instance
+                _unpublish_window();
                 _window.reset();
             }
         }
@@ -444,6 +492,16 @@ namespace View {
         return _running;
     }
 
+    void win32_backend::post_to_ui_thread(std::function<void()> task)
+    {
+        _ui_queue.post_task(std::move(task));
+
+        //  PostMessage can be called from any thread
+        const auto window = _native_window.load();
+        if (window != nullptr)
+            PostMessage(reinterpret_cast<HWND>(window), WM_VIEW_RUN_UI_TASKS, 0, 0);
+    }
+
     bool win32_backend::vst2_char_input(char c)
     {
         // Apply only on a child windows (for audio plugins)
@@ -456,13 +514,29 @@ namespace View {
     void win32_backend::_app_window_proc(win32_backend* self, const std::string& title)
     {
         // Window must be create, used and deleted in the same thread
-        self->_window = std::make_unique<win32_window>(self->_root, self->_pixel_per_unit, title);
+        self->_window = std::make_unique<win32_window>(self->_root, self->_pixel_per_unit, self->_ui_queue, title);
+        self->_publish_window();
 
         //  Manage event until windows is closed
         self->_window->manage_event_loop(self->_running);
 
         //  Destroy window
+        self->_unpublish_window();
         self->_window.reset();
     }
 
+    void win32_backend::_publish_window()
+    {
+        const auto window = _window->native_handle();
+        _native_window.store(window);
+
+        //  Execute the closures posted while there was no window
+        PostMessage(window, WM_VIEW_RUN_UI_TASKS, 0, 0);
+    }
+
+    void win32_backend::_unpublish_window()
+    {
+        _native_window.store(nullptr);
+    }
+
 } /* View */
\ No newline at end of file
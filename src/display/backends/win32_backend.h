@@ -1,10 +1,12 @@
 #ifndef VIEW_WIN_BACKEND_H_
 #define VIEW_WIN_BACKEND_H_
 
+#include <atomic>
 #include <thread>
 #include <memory>
 
 #include "view_backend.h"
+#include "display/common/ui_task_queue.h"
 
 namespace View {
 
@@ -24,14 +26,21 @@ namespace View {
         void wait_window_thread() override;
         void close_window() override;
         bool windows_is_open() const noexcept override;
+        void post_to_ui_thread(std::function<void()> task) override;
 
         bool vst2_char_input(char) override;
     private:
         static void _app_window_proc(win32_backend* self, const std::string& title);
+        void _publish_window();
+        void _unpublish_window();
 
         std::unique_ptr<win32_window> _window{};
         std::thread _window_thread{};
         bool _running{false};
+
+        //  Closures posted from other threads, and the window (HWND) notified when posting
+        ui_task_queue _ui_queue{};
+        std::atomic<void*> _native_window{nullptr};
     };
 
 }
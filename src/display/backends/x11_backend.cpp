@@ -1,9 +1,20 @@
 
 #include <cstring>
-#include <optional>
+#include <algorithm>
 #include <array>
 #include <chrono>
+#include <future>
 #include <iostream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
 
 #include <X11/X.h>
 #include <X11/Xlib.h>
@@ -13,20 +24,136 @@
 #include <X11/Xlocale.h>
 
 #include "x11_backend.h"
+#include "x11_render_context.h"
 
 #include "display/common/display_controler.h"
 #include "display/common/widget_adapter.h"
-#include "internal_fonts/internal_fonts.h"
+#include "display/common/damage_region.h"
+#include "display/common/gl_framebuffer.h"
+#include "display/common/gl_renderer.h"
+#include "display/common/ui_task_queue.h"
 
-#include <GL/glew.h>
-#include <GL/gl.h>
-#include <GL/glx.h>
-#include <GL/glu.h>
+namespace View {
 
-#include "nanovg.h"
-#include "nanovg_gl.h"
+    /**
+     *  Wake up channel : allow other threads to interrupt the event loop
+     *  when it is blocked waiting for X events.
+     */
+    static void create_wakeup_channel(int& read_fd, int& write_fd)
+    {
+#ifdef __linux__
+        read_fd = write_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#else
+        int fds[2];
+        if (pipe(fds) == 0) {
+            fcntl(fds[0], F_SETFL, O_NONBLOCK);
+            fcntl(fds[1], F_SETFL, O_NONBLOCK);
+            read_fd = fds[0];
+            write_fd = fds[1];
+        }
+#endif
+        if (read_fd < 0 || write_fd < 0)
+            throw std::runtime_error("Unable to create the event loop wake up channel");
+    }
 
-namespace View {
+    static void close_wakeup_channel(int read_fd, int write_fd)
+    {
+        if (write_fd != read_fd)
+            close(write_fd);
+        close(read_fd);
+    }
+
+    static void notify_wakeup_channel(int write_fd)
+    {
+#ifdef __linux__
+        const uint64_t value = 1u;
+        (void)write(write_fd, &value, sizeof(value));
+#else
+        const char value = 1;
+        (void)write(write_fd, &value, sizeof(value));
+#endif
+    }
+
+    static void clear_wakeup_channel(int read_fd)
+    {
+        //  Descriptors are non blocking : read until nothing is left
+        uint64_t buffer;
+        while (read(read_fd, &buffer, sizeof(buffer)) > 0);
+    }
+
+    /**
+     *  \class x11_runtime
+     *  \brief Process wide X11 event loop : one display connection and one thread for every window
+     *  \details Events are dispatched to the windows by their X11 id. Windows are created,
+     *  used and destroyed by the runtime thread only. The runtime is reference counted by the
+     *  backends : it is started with the first one and stopped with the last one.
+     */
+    class x11_runtime {
+    public:
+        static std::shared_ptr<x11_runtime> acquire();
+
+        x11_runtime(const x11_runtime&) = delete;
+        ~x11_runtime();
+
+        Display *display() const noexcept { return _display; }
+        bool is_runtime_thread() const noexcept { return std::this_thread::get_id() == _thread.get_id(); }
+
+        /**
+         *  \brief Execute a task on the runtime thread, from any thread
+         */
+        void post(std::function<void()> task);
+
+        /**
+         *  \brief Interrupt the runtime thread wait, from any thread
+         */
+        void wake_up();
+
+        /**
+         *  \brief Add or remove a window in the event dispatch (runtime thread only)
+         */
+        void register_window(Window window, x11_backend& backend);
+        void unregister_window(Window window);
+
+        /**
+         *  \brief Destroy a closed window once the current event or update returned (runtime thread only)
+         *  \details The window may be closed by one of its own event handlers, which is still running.
+         */
+        void retire_window(std::unique_ptr<x11_window> window);
+
+        /**
+         *  \brief Select the window whose buffer swaps wait for the display (runtime thread only)
+         *  \details Every window is presented by the runtime thread : if each swap waited for the
+         *  vertical blank, n windows would run at 1/n of the refresh rate. Only one registered window
+         *  is synchronized, the other ones swap immediately and are paced to the display refresh by
+         *  their frame scheduler.
+         *  \return true if the window is the synchronized one
+         */
+        bool claim_vsync(Window window);
+
+        /**
+         *  \brief Give the synchronization to an other window using vsync, if any (runtime thread only)
+         */
+        void release_vsync(Window window);
+
+    private:
+        x11_runtime();
+
+        void _run();
+        void _dispatch_event(const XEvent& event, std::chrono::steady_clock::time_point received);
+        int _update_windows();
+        void _wait_events(int timeout_ms);
+
+        Display *_display{nullptr};
+        int _wakeup_read_fd{-1};
+        int _wakeup_write_fd{-1};
+        ui_task_queue _tasks{};
+        std::unordered_map<Window, x11_backend*> _windows{};
+        std::vector<Window> _updated_windows{};
+        std::vector<std::unique_ptr<x11_window>> _retired_windows{};
+        Window _vsync_window{0};
+        std::atomic<bool> _running{true};
+        std::thread _thread{};
+    };
 
     class x11_window : private widget_adapter {
 
@@ -43,15 +170,37 @@ namespace View {
             ConfigureNotify;
 
     public:
-        x11_window(Window parent, widget& root, const std::string& title, float pixel_per_unit);
+        x11_window(x11_backend& backend, Display *display, Window parent, const std::string& title);
         x11_window(x11_window&) = delete;
         ~x11_window();
 
+        Window id() const noexcept { return _window; }
+
         /**
-         *  \brief manage the window
-         *  \param running ref to a boolean value looked after to close the windows
-         **/
-        void process(const bool& running);
+         *  \brief Stop using the backend and the root widget, which may be destroyed before the window
+         */
+        void close() noexcept;
+
+        using widget_adapter::set_motion_compression;
+
+        /**
+         *  \brief Handle an event received for this window
+         *  \param received when the event was read from the connection
+         *  \return true if the window should be closed
+         */
+        bool process_event(const XEvent& event, std::chrono::steady_clock::time_point received);
+
+        /**
+         *  \brief Handle closures and damaged areas posted from other threads, and redraw if needed
+         *  \return the time to wait before the next update in milliseconds, or -1 if nothing is pending
+         */
+        int update();
+
+        /**
+         *  \brief Synchronize buffer swaps with the display, if supported by the driver
+         *  \details Only the window selected by the runtime wait for the display, see x11_runtime::claim_vsync
+         */
+        void set_vsync(vsync_mode mode);
 
         //  display controller interface
         void set_cursor(cursor c) override;
@@ -61,16 +210,18 @@ namespace View {
         void sys_invalidate_rect(const draw_area& area) override;
 
         //  Internal helpers
+        bool _handle_event(const XEvent& event);
         void _resize_window(unsigned int width, unsigned int height);
-        bool _process_event(const XEvent& event, std::optional<draw_area>& redraw_area);    // return true if window should be closed
 
-        void _redraw_area(draw_area area);
+        void _redraw_damage();
         void _redraw_window();
+        void _present();
+        std::chrono::nanoseconds _query_refresh_interval();
 
         void _initialize_cursors();
         void _free_cursors();
 
-        //  X11 members
+        //  X11 members (the display connection belong to the runtime)
         Display *_display{nullptr};
         Window _window{0};
         Window _parent{0};
@@ -80,30 +231,53 @@ namespace View {
         //  dbl click detection
         Time _last_click_time{};
 
-        //  Drawing context
-        GLXContext _glx;
+        //  Owner : hold the cross thread communication queue and the frame scheduler
+        x11_backend& _backend;
+        frame_scheduler& _scheduler;
+        input_latency_tracker& _latency;
+
+        //  Drawing context, shared with the other windows
+        std::shared_ptr<x11_render_context> _render_context;
         NVGcontext *_vg;
 
-        // for concurent redraw
-        std::thread::id _event_loop_thread_id{};
-        bool _dirty{false};
+        //  Window content is kept here between frames, as the back buffer content is
+        //  undefined after a swap : only the damaged areas have to be redrawn.
+        //  Belong to the shared context.
+        gl_framebuffer _framebuffer{};
+
+        //  Area that must be redrawn at next frame
+        damage_region _damage{};
+
+        //  The window content was lost (exposed) but the framebuffer is still valid
+        bool _present_needed{false};
+
+        //  The backend was closed, possibly destroyed, by an event handler or a posted closure
+        bool _closed{false};
     };
 
-    x11_window::x11_window(Window parent, widget& root, const std::string& title, float pixel_per_unit)
-    :   widget_adapter{root, pixel_per_unit}
+    x11_window::x11_window(x11_backend& backend, Display *display, Window parent, const std::string& title)
+    :   widget_adapter{backend._root, backend._pixel_per_unit},
+        _display{display},
+        _backend{backend},
+        _scheduler{backend._scheduler},
+        _latency{backend._latency},
+        _render_context{x11_render_context::acquire(backend._renderer)},
+        _vg{_render_context->nvg()}
     {
         const auto width = display_width();
         const auto height = display_height();
 
-        _display = XOpenDisplay(nullptr /* display name*/);
-
-    if (_display == nullptr)
-        throw std::runtime_error("Unable to open X display");
-
+        //  The window must use the visual of the shared drawing context
+        XVisualInfo visual_template;
+        std::memset(&visual_template, 0, sizeof(visual_template));
+        visual_template.visualid = _render_context->visual_id();
+        int visual_count = 0;
 
-        int attributes[] = {GLX_RGBA, GLX_DEPTH_SIZE, 24, GLX_DOUBLEBUFFER, None};
         Window root_window = DefaultRootWindow(_display);
-        XVisualInfo *visual_info =  glXChooseVisual(_display, 0, attributes);
+        XVisualInfo *visual_info = XGetVisualInfo(_display, VisualIDMask, &visual_template, &visual_count);
+
+    if (visual_info == nullptr)
+        throw std::runtime_error("Unable to find the drawing context visual");
 
         //  Create the windows
         const auto screen_id = DefaultScreen(_display);
@@ -118,7 +292,7 @@ namespace View {
             XCreateWindow(
                 _display, root_window,
                 0, 0, width, height, 0,
-                CopyFromParent, CopyFromParent,
+                visual_info->depth, InputOutput,
                 visual_info->visual,
                 CWColormap, &xattributs);
 
@@ -142,30 +316,24 @@ namespace View {
         //  Initialize cursors
         _initialize_cursors();
 
-        //  Map (show) the windows and wait untile it is mapped
+        //  Map (show) the windows and wait untile it is mapped.
+        //  Events for the other windows are left in the queue.
         XMapWindow(_display, _window);
         XEvent event;
         do {
-            XNextEvent(_display, &event);
+            XWindowEvent(_display, _window, StructureNotifyMask, &event);
         } while (event.type != MapNotify);
 
-        //  Prepare drawing context
-
-        //  GLX + OpenGL
-        _glx = glXCreateContext(_display, visual_info, nullptr, 1);
-        glXMakeCurrent(_display, _window, _glx);
-        glewInit();
-        glEnable(GL_STENCIL_TEST);
-        glClearColor(0.0, 0.0, 0.0, 1.0);
+        XFree(visual_info);
 
-        free(visual_info);
+        //  Prepare drawing context : vsync is set once the window is registered in the runtime
+        set_motion_compression(backend._motion_compression);
 
-        //  NanoVG
-        _vg = nvgCreateGL2(NVG_ANTIALIAS | NVG_STENCIL_STROKES | NVG_DEBUG);
-
-        //  Intitialize internals fonts
-        create_roboto_regular_font(_vg);
-        create_roboto_bold_font(_vg);
+        //  Rasterize the common glyphs now rather than during the first frame
+        {
+            auto scope = _render_context->make_current(_window);
+            sys_prerender_glyphs(_vg);
+        }
 
         //  Adapt windows content to the actual size
         XWindowAttributes win_attrib;
@@ -174,15 +342,25 @@ namespace View {
 
         //  Initial windows drawing
         _redraw_window();
+        _damage.clear();
     }
 
     x11_window::~x11_window()
     {
-        nvgDeleteGL2(_vg);
-        glXDestroyContext(_display, _glx);
+        {
+            auto scope = _render_context->make_current(_window);
+            _framebuffer.release();
+        }
+
         XDestroyWindow(_display, _window);
         _free_cursors();
-        XCloseDisplay(_display);
+        XFlush(_display);
+    }
+
+    void x11_window::close() noexcept
+    {
+        _closed = true;
+        detach_root();
     }
 
     void x11_window::set_cursor(cursor c)
@@ -190,61 +368,118 @@ namespace View {
         XDefineCursor(_display, _window, x11_cursors[static_cast<int>(c)]);
     }
 
-    void x11_window::process(const bool& running)
+    int x11_window::update()
     {
-        constexpr auto frame_interval = std::chrono::duration<float>{1.f/120.f};
-        std::optional<draw_area> redraw_area = std::nullopt;
+        //  Handle what was posted by other threads.
+        //  A closure may close the window : the backend must not be used after that
+        while (!_closed && _backend._ui_queue.run_task());
 
-        auto last_draw = std::chrono::steady_clock::now();
+        if (_closed)
+            return -1;
 
-        _event_loop_thread_id = std::this_thread::get_id();
+        //  Mouse moves are delivered once per frame, just before drawing
+        const auto remaining = _scheduler.time_until_next_frame(frame_scheduler::clock::now());
+        const bool frame_ready = (remaining == frame_scheduler::clock::duration::zero());
 
-        while (running)
-        {
-            //  Sleep reduce drastically cpu usage of active polling
-            std::this_thread::sleep_for(frame_interval/2.f);
+        if (frame_ready) {
+            //  The coalesced moves are one input event
+            _latency.begin_motion_dispatch();
+            flush_mouse_move();
 
-            //  There are some event to be processed
-            while (XPending(_display)) {
-                XEvent event;
-                XNextEvent(_display, &event);
-                if (_process_event(event, redraw_area))
-                    return;
-            }
+            if (_closed)
+                return -1;
 
-            //  Redraw if something need to be redrawn and a sufficient
-            //  amount of time have elapsed since last redraw
-            const auto now = std::chrono::steady_clock::now();
-            if (_dirty) {
-                _redraw_window();
-                _dirty = false;
-            }
-            else if (redraw_area) {
-                const auto current_interval = now - last_draw;
+            _latency.end_event();
+        }
 
-                if (current_interval >= frame_interval) {
-                    _redraw_area(redraw_area.value());
-                    last_draw = std::chrono::steady_clock::now();
-                    redraw_area = std::nullopt;
-                }
+        _backend._ui_queue.drain_damage(_damage, make_rectangle(0, display_height(), 0, display_width()));
+
+        //  Redraw if something need to be redrawn and the scheduler allows a new frame.
+        //  Every damage received until then is drawn in the same frame.
+        int timeout_ms = -1; // Nothing to do : wait for an event
+
+        if (!_damage.empty() || has_pending_mouse_move()) {
+            if (frame_ready) {
+                _redraw_damage();
+                _damage.clear();
             }
+            else {
+                //  Wake up in time for the next frame
+                timeout_ms = static_cast<int>(
+                    std::chrono::ceil<std::chrono::milliseconds>(remaining).count());
+            }
+        }
+
+        //  Exposed areas are copied back from the framebuffer, without drawing any widget
+        if (_present_needed) {
+            auto scope = _render_context->make_current(_window);
+            _present();
+        }
+
+        //  Nothing is waiting to be drawn : the last input events had no visible effect
+        if (timeout_ms < 0)
+            _latency.discard_pending();
+
+        //  Rasterize the glyphs posted for the next frames, a slice per update
+        if (sys_glyphs_pending(_vg)) {
+            auto scope = _render_context->make_current(_window);
+
+            if (sys_warmup_glyphs(_vg) && timeout_ms < 0)
+                timeout_ms = 0;
         }
 
-        _event_loop_thread_id = {};
+        return timeout_ms;
     }
 
     void x11_window::_resize_window(unsigned int width, unsigned int height)
     {
         //  Notify the content that window size has changed
         resize_display(width, height);
-        //  Update drawing context
+
+        //  Update drawing context : the framebuffer content is lost
+        //  Called on the runtime thread shared by every window : a failure must not throw.
+        //  Nothing is drawn nor presented until the framebuffer can be allocated
+        auto scope = _render_context->make_current(_window);
+        if (!_framebuffer.resize(width, height))
+            std::cerr << "x11_backend : unable to allocate a " << width << "x" << height << " framebuffer" << std::endl;
+
         glViewport(0, 0, width, height);
+        _damage.add(make_rectangle(0, height, 0, width));
     }
 
-    bool x11_window::_process_event(const XEvent& event, std::optional<draw_area>& redraw_area)
+    bool x11_window::process_event(const XEvent& event, std::chrono::steady_clock::time_point received)
     {
-        const auto thread_id = std::this_thread::get_id();
+        //  Input events are followed until the frame presenting them
+        Time server_time;
 
+        switch (event.type)
+        {
+            case ButtonPress:
+            case ButtonRelease:     server_time = event.xbutton.time;   break;
+            case KeyPress:          server_time = event.xkey.time;      break;
+            case EnterNotify:
+            case LeaveNotify:       server_time = event.xcrossing.time; break;
+            case MotionNotify:
+                //  Only queued : followed from its dispatch, with the next flush or event
+                _latency.queue_motion(static_cast<std::uint32_t>(event.xmotion.time), received);
+                return _handle_event(event);
+
+            default:                return _handle_event(event);
+        }
+
+        _latency.begin_event(static_cast<std::uint32_t>(server_time), received);
+        const auto close = _handle_event(event);
+
+        //  The backend may have been destroyed by the event handlers
+        if (_closed)
+            return false;
+
+        _latency.end_event();
+        return close;
+    }
+
+    bool x11_window::_handle_event(const XEvent& event)
+    {
         switch (event.type)
         {
 
@@ -270,7 +505,7 @@ namespace View {
                     const auto delta = now - _last_click_time;
 
                     sys_mouse_button_up(mouse_button::left);
-                    if (delta > 50 && delta < 250)
+                    if (!_closed && delta > 50 && delta < 250)
                         sys_mouse_dbl_click();
 
                     _last_click_time = now;
@@ -297,23 +532,15 @@ namespace View {
         break;
 
         case MotionNotify:
-            sys_mouse_move(
+            //  Coalesced until the next frame
+            queue_mouse_move(
                 static_cast<unsigned int>(event.xmotion.x),
                 static_cast<unsigned int>(event.xmotion.y));
         break;
 
         case Expose:
-            {
-                const auto exposed_area = make_rectangle(
-                    event.xexpose.y, event.xexpose.y + event.xexpose.height,
-                    event.xexpose.x, event.xexpose.x + event.xexpose.width);
-
-                //  Update redraw area
-                if (redraw_area)
-                    redraw_area = exposed_area.bounding(redraw_area.value());
-                else
-                    redraw_area = exposed_area;
-            }
+            //  The framebuffer still hold the window content
+            _present_needed = true;
         break;
 
         //  Do not send Mouse enter/exit event for children windows
@@ -349,42 +576,135 @@ namespace View {
         return false;
     }
 
-    void x11_window::_redraw_area(draw_area area)
+    void x11_window::set_vsync(vsync_mode mode)
+    {
+        //  Before making the context current : an other window may be synchronized instead
+        if (mode == vsync_mode::off)
+            _backend._runtime->release_vsync(_window);
+
+        const bool synchronized = (mode != vsync_mode::off) && _backend._runtime->claim_vsync(_window);
+        auto scope = _render_context->make_current(_window);
+        const auto display = _render_context->display();
+        int interval = synchronized ? 1 : 0;
+
+        //  Adaptive vsync : late frames are swapped immediately
+        if (synchronized && mode == vsync_mode::adaptive && _render_context->has_extension("GLX_EXT_swap_control_tear"))
+            interval = -1;
+
+        if (_render_context->has_extension("GLX_EXT_swap_control")) {
+            const auto swap_interval_ext = reinterpret_cast<PFNGLXSWAPINTERVALEXTPROC>(
+                glXGetProcAddress(reinterpret_cast<const GLubyte*>("glXSwapIntervalEXT")));
+            swap_interval_ext(display, _window, interval);
+        }
+        else if (_render_context->has_extension("GLX_MESA_swap_control")) {
+            const auto swap_interval_mesa = reinterpret_cast<PFNGLXSWAPINTERVALMESAPROC>(
+                glXGetProcAddress(reinterpret_cast<const GLubyte*>("glXSwapIntervalMESA")));
+            swap_interval_mesa(interval < 0 ? 1 : interval);
+        }
+        else {
+            //  Swap interval can not be changed : keep the driver default
+            return;
+        }
+
+        //  Frames are not drawn faster than the display refresh (when it can be queried) : this
+        //  pace the windows which are not synchronized, and swap without waiting
+        _scheduler.set_refresh_interval(
+            mode == vsync_mode::off ? std::chrono::nanoseconds::zero() : _query_refresh_interval());
+    }
+
+    std::chrono::nanoseconds x11_window::_query_refresh_interval()
     {
+        if (_render_context->has_extension("GLX_OML_sync_control")) {
+            const auto get_msc_rate = reinterpret_cast<PFNGLXGETMSCRATEOMLPROC>(
+                glXGetProcAddress(reinterpret_cast<const GLubyte*>("glXGetMscRateOML")));
+            int32_t numerator = 0;
+            int32_t denominator = 0;
+
+            if (get_msc_rate(_render_context->display(), _window, &numerator, &denominator) && numerator > 0)
+                return std::chrono::nanoseconds{1000000000ll * denominator / numerator};
+        }
+
+        return std::chrono::nanoseconds::zero();    //  unknown
+    }
+
+    void x11_window::_redraw_damage()
+    {
+        if (_framebuffer.empty())
+            return;
+
         const auto window_area = make_rectangle(0, display_height(), 0, display_width());
 
-        //  Add security pixels to be sure border are correctly redrawn
+        //  Add security pixels to be sure border are correctly redrawn. The grown areas can overlap :
+        //  they are merged again into a region whose rectangles are disjoint
         const auto pixel_offset = 2;
-        area.top -= pixel_offset;
-        area.bottom += pixel_offset;
-        area.left -= pixel_offset;
-        area.right += pixel_offset;
-
-        //  Compute intersection beetween area and windows (what we actually need to redraw)
-        draw_area drawing_area;
-        if (area.intersect(window_area, drawing_area)) {
+
+        damage_region drawing_region{};
+
+        auto scope = _render_context->make_current(_window);
+        _scheduler.begin_frame();
+
+        for (auto area : _damage) {
+            area.top -= pixel_offset;
+            area.bottom += pixel_offset;
+            area.left -= pixel_offset;
+            area.right += pixel_offset;
+
+            //  Compute intersection beetween area and windows (what we actually need to redraw)
+            draw_area drawing_area;
+            if (area.intersect(window_area, drawing_area))
+                drawing_region.add(drawing_area);
+        }
+
+        _framebuffer.bind();
+
+        //  The framebuffer content is kept between frames : only clear the redrawn areas
+        glEnable(GL_SCISSOR_TEST);
+        for (const auto& area : drawing_region) {
+            glScissor(area.left, display_height() - area.bottom, area.width(), area.height());
             glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-            nvgBeginFrame(_vg, display_width(), display_height(), 1.);
+        }
+        glDisable(GL_SCISSOR_TEST);
+
+        nvgBeginFrame(_vg, display_width(), display_height(), 1.);
+
+        for (const auto& drawing_area : drawing_region) {
+            nvgSave(_vg);
+
+            //  Do not draw outside the cleared area
+            nvgScissor(_vg, drawing_area.left, drawing_area.top, drawing_area.width(), drawing_area.height());
 
             //  Redraw
             sys_draw_rect(_vg, drawing_area.top, drawing_area.bottom, drawing_area.left, drawing_area.right);
 
+            nvgRestore(_vg);
+
 #ifdef VIEW_DEBUG_HIGHLIGHT_REDRAW_AREA
             nvgBeginPath(_vg);
-            nvgRect(_vg, area.left, area.top, area.right - area.left, area.bottom - area.top);
+            nvgRect(_vg, drawing_area.left, drawing_area.top, drawing_area.width(), drawing_area.height());
             nvgStrokeColor(_vg, nvgRGBf(1., 0., 0.));
             nvgStrokeWidth(_vg, pixel_offset);
             nvgStroke(_vg);
 #endif
-            nvgEndFrame(_vg);
-            glXSwapBuffers(_display, _window);
-            XFlush(_display);
         }
+
+        nvgEndFrame(_vg);
+        sys_update_layers(_vg);
+        _scheduler.end_draw();
+        _latency.end_draw();
+        _present();
+        _scheduler.end_frame();
+        _latency.end_frame();
     }
 
     void x11_window::_redraw_window()
     {
         // std::cout << "Redraw window" << std::endl;
+        if (_framebuffer.empty())
+            return;
+
+        auto scope = _render_context->make_current(_window);
+        _scheduler.begin_frame();
+        _framebuffer.bind();
         glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
         nvgBeginFrame(_vg, display_width(), display_height(), 1.);
 
@@ -392,30 +712,38 @@ namespace View {
         sys_draw(_vg);
 
         nvgEndFrame(_vg);
-        glXSwapBuffers(_display, _window);
-        XFlush(_display);
+        sys_update_layers(_vg);
+        _scheduler.end_draw();
+        _latency.end_draw();
+        _present();
+        _scheduler.end_frame();
+        _latency.end_frame();
     }
 
-    void x11_window::sys_invalidate_rect(const draw_area& area)
+    void x11_window::_present()
     {
-        if (_event_loop_thread_id == std::this_thread::get_id()) {
-            XEvent ev;
-            std::memset(&ev, 0, sizeof(ev));
+        _present_needed = false;
 
-            ev.type = Expose;
+        if (_framebuffer.empty())
+            return;
 
-            ev.xexpose.x = area.left;
-            ev.xexpose.y = area.top;
-            ev.xexpose.width = area.right - area.left;
-            ev.xexpose.height = area.bottom - area.top;
-            ev.xexpose.window = _window;
+        //  The whole back buffer is refreshed from the framebuffer, which is cheap compared to drawing widgets
+        _framebuffer.blit_to_default();
+        const auto display = _render_context->display();
+        glXSwapBuffers(display, _window);
+        XFlush(display);
+    }
 
-            XSendEvent(_display, _window, true, ExposureMask, &ev);
-            XFlush(_display);
+    void x11_window::sys_invalidate_rect(const draw_area& area)
+    {
+        if (_backend._runtime->is_runtime_thread()) {
+            //  Redrawn at next frame
+            _damage.add(area);
         }
         else {
-            // called from another thread
-            _dirty = true;
+            // called from another thread : handled by the event loop at next iteration
+            _backend._ui_queue.post_damage(area);
+            _backend._runtime->wake_up();
         }
     }
 
@@ -440,35 +768,253 @@ namespace View {
     }
 
 
+    /**
+     *
+     *      x11_runtime implementation
+     *
+     */
+    std::shared_ptr<x11_runtime> x11_runtime::acquire()
+    {
+        static std::mutex instance_mutex{};
+        static std::weak_ptr<x11_runtime> instance{};
+
+        std::lock_guard<std::mutex> lock{instance_mutex};
+        auto runtime = instance.lock();
+
+        if (!runtime) {
+            runtime = std::shared_ptr<x11_runtime>{new x11_runtime{}};
+            instance = runtime;
+        }
+
+        return runtime;
+    }
+
+    x11_runtime::x11_runtime()
+    {
+        _display = XOpenDisplay(nullptr /* display name*/);
+
+    if (_display == nullptr)
+        throw std::runtime_error("Unable to open X display");
+
+        create_wakeup_channel(_wakeup_read_fd, _wakeup_write_fd);
+        _thread = std::thread{[this]() { _run(); }};
+    }
+
+    x11_runtime::~x11_runtime()
+    {
+        //  Every window was closed by its backend, and the last backend
+        //  released the runtime from an other thread : see ~x11_backend
+        _running = false;
+        wake_up();
+        _thread.join();
+
+        close_wakeup_channel(_wakeup_read_fd, _wakeup_write_fd);
+        XCloseDisplay(_display);
+    }
+
+    void x11_runtime::post(std::function<void()> task)
+    {
+        _tasks.post_task(std::move(task));
+        wake_up();
+    }
+
+    void x11_runtime::wake_up()
+    {
+        notify_wakeup_channel(_wakeup_write_fd);
+    }
+
+    void x11_runtime::register_window(Window window, x11_backend& backend)
+    {
+        _windows[window] = &backend;
+    }
+
+    void x11_runtime::unregister_window(Window window)
+    {
+        _windows.erase(window);
+        release_vsync(window);
+    }
+
+    void x11_runtime::retire_window(std::unique_ptr<x11_window> window)
+    {
+        _retired_windows.push_back(std::move(window));
+    }
+
+    bool x11_runtime::claim_vsync(Window window)
+    {
+        if (_vsync_window == 0 && _windows.count(window) != 0u)
+            _vsync_window = window;
+
+        return _vsync_window == window;
+    }
+
+    void x11_runtime::release_vsync(Window window)
+    {
+        if (_vsync_window != window)
+            return;
+
+        _vsync_window = 0;
+
+        for (const auto& entry : _windows) {
+            const auto mode = entry.second->_vsync.load();
+
+            if (entry.first != window && mode != vsync_mode::off) {
+                entry.second->_window->set_vsync(mode);
+                break;
+            }
+        }
+    }
+
+    void x11_runtime::_run()
+    {
+        while (_running) {
+            //  Create and destroy windows
+            _tasks.run_tasks();
+
+            //  Process every event already received
+            const auto received = std::chrono::steady_clock::now();
+
+            while (XPending(_display)) {
+                XEvent event;
+                XNextEvent(_display, &event);
+                _dispatch_event(event, received);
+            }
+
+            const auto timeout_ms = _update_windows();
+
+            //  No handler of the windows closed during this iteration is running anymore
+            _retired_windows.clear();
+
+            if (_running)
+                _wait_events(timeout_ms);
+        }
+    }
+
+    void x11_runtime::_dispatch_event(const XEvent& event, std::chrono::steady_clock::time_point received)
+    {
+        const auto it = _windows.find(event.xany.window);
+
+        //  Events received for a window that was already destroyed are ignored
+        if (it == _windows.end())
+            return;
+
+        if (it->second->_window->process_event(event, received)) {
+            //  The handlers may have closed the window, or destroyed its backend
+            const auto still_open = _windows.find(event.xany.window);
+
+            if (still_open != _windows.end())
+                still_open->second->_destroy_window();
+        }
+    }
+
+    int x11_runtime::_update_windows()
+    {
+        int timeout_ms = -1;
+
+        //  Windows may be closed, or opened, by the closures and handlers run by an update
+        _updated_windows.clear();
+        for (const auto& entry : _windows)
+            _updated_windows.push_back(entry.first);
+
+        for (const auto window : _updated_windows) {
+            const auto it = _windows.find(window);
+
+            if (it == _windows.end())
+                continue;
+
+            const auto window_timeout = it->second->_window->update();
+
+            if (window_timeout >= 0)
+                timeout_ms = (timeout_ms < 0) ? window_timeout : std::min(timeout_ms, window_timeout);
+        }
+
+        return timeout_ms;
+    }
+
+    void x11_runtime::_wait_events(int timeout_ms)
+    {
+        //  Events may have been read from the connection and queued by Xlib
+        if (XEventsQueued(_display, QueuedAfterFlush) > 0)
+            return;
+
+        std::array<pollfd, 2> fds{};
+        fds[0].fd = ConnectionNumber(_display);
+        fds[0].events = POLLIN;
+        fds[1].fd = _wakeup_read_fd;
+        fds[1].events = POLLIN;
+
+        if (poll(fds.data(), fds.size(), timeout_ms) > 0 && (fds[1].revents & POLLIN))
+            clear_wakeup_channel(_wakeup_read_fd);
+    }
+
     /**
      *
      *      x11_backend implementation
      *
      */
-    x11_backend::x11_backend(widget& root, float pixel_per_unit)
-    : view_backend{root, pixel_per_unit}
+    x11_backend::x11_backend(widget& root, float pixel_per_unit, gl_version renderer)
+    :   view_backend{root, pixel_per_unit},
+        _renderer{renderer},
+        _runtime{x11_runtime::acquire()}
     {
     }
 
+    x11_backend::~x11_backend()
+    {
+        close_window();
+
+        //  The runtime thread can not join itself : if this is the last backend,
+        //  the runtime is released, and its thread joined, by an other thread
+        if (_runtime->is_runtime_thread())
+            std::thread{[runtime = std::move(_runtime)]() {}}.detach();
+    }
+
     void x11_backend::create_window(const std::string& title, void *parent)
     {
-        if (_running == false) {
+        std::lock_guard<std::mutex> lock{_state_mutex};
+
+        if (_window_open == false) {
+            _window_open = true;
             _running = true;
-            _window_thread =
-                std::thread{ _window_proc, this, reinterpret_cast<Window>(parent), title};
+            _runtime->post(
+                [this, lifetime = std::weak_ptr<void>{_lifetime}, parent = reinterpret_cast<Window>(parent), title]()
+                {
+                    //  The backend may have been destroyed on the runtime thread before
+                    if (!lifetime.expired())
+                        _open_window(parent, title);
+                });
         }
     }
 
     void x11_backend::wait_window_thread()
     {
-        if (_window_thread.joinable())
-            _window_thread.join();
+        //  The window can not be closed while the runtime thread is blocked
+        if (_runtime->is_runtime_thread())
+            return;
+
+        std::unique_lock<std::mutex> lock{_state_mutex};
+        _state_condition.wait(lock, [this]() { return !_window_open; });
     }
 
     void x11_backend::close_window()
     {
         _running = false;
-        wait_window_thread();
+
+        if (_runtime->is_runtime_thread()) {
+            //  Called by an event handler or a closure : the window is destroyed now,
+            //  so that the runtime never reach this backend again
+            _destroy_window();
+        }
+        else {
+            //  Wait for this very closure, which use the backend, even if the window is already closed
+            std::promise<void> destroyed{};
+            _runtime->post(
+                [this, &destroyed]()
+                {
+                    _destroy_window();
+                    destroyed.set_value();
+                });
+            destroyed.get_future().wait();
+        }
     }
 
     bool x11_backend::windows_is_open() const noexcept
@@ -476,10 +1022,85 @@ namespace View {
         return _running;
     }
 
-    void x11_backend::_window_proc(x11_backend *self, Window parent, const std::string& title)
+    void x11_backend::post_to_ui_thread(std::function<void()> task)
     {
-        x11_window win{parent, self->_root, title, self->_pixel_per_unit};
-        win.process(self->_running);
-        self->_running = false;
+        _ui_queue.post_task(std::move(task));
+        _runtime->wake_up();
+    }
+
+    void x11_backend::set_vsync(vsync_mode mode)
+    {
+        _vsync = mode;
+
+        //  Applied by the runtime thread, which own the OpenGL context
+        post_to_ui_thread(
+            [this, mode]()
+            {
+                if (_window)
+                    _window->set_vsync(mode);
+            });
+    }
+
+    void x11_backend::set_max_fps(float fps)
+    {
+        _scheduler.set_max_fps(fps);
+        _runtime->wake_up();
+    }
+
+    void x11_backend::set_motion_compression(bool enabled)
+    {
+        _motion_compression = enabled;
+
+        post_to_ui_thread(
+            [this, enabled]()
+            {
+                if (_window)
+                    _window->set_motion_compression(enabled);
+            });
+    }
+
+    frame_statistics x11_backend::get_frame_statistics() const
+    {
+        return _scheduler.statistics();
+    }
+
+    input_latency_statistics x11_backend::get_input_latency_statistics() const
+    {
+        return _latency.statistics();
+    }
+
+    void x11_backend::_open_window(Window parent, const std::string& title)
+    {
+        //  The window may have been closed before being created
+        if (!_running || _window)
+            return;
+
+        _scheduler.reset_statistics();
+
+        try {
+            _window = std::make_unique<x11_window>(*this, _runtime->display(), parent, title);
+            _runtime->register_window(_window->id(), *this);
+            _window->set_vsync(_vsync);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "x11_backend : unable to open the window : " << e.what() << std::endl;
+            _destroy_window();
+        }
+    }
+
+    void x11_backend::_destroy_window()
+    {
+        if (_window) {
+            //  The window handlers may still be running : it is destroyed later by the runtime
+            _runtime->unregister_window(_window->id());
+            _window->close();
+            _runtime->retire_window(std::move(_window));
+        }
+
+        _running = false;
+
+        std::lock_guard<std::mutex> lock{_state_mutex};
+        _window_open = false;
+        _state_condition.notify_all();
     }
 }
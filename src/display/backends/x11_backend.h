@@ -1,36 +1,85 @@
 #ifndef VIEW_X11_BACKEND_H_
 #define VIEW_X11_BACKEND_H_
 
-#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 
 #include "view_backend.h"
+#include "display/common/gl_renderer.h"
+#include "display/common/ui_task_queue.h"
 
 namespace View {
 
+    class x11_window;
+    class x11_runtime;
+
     /**
      *  \class x11_backend
      *  \brief
+     *  \details Every x11_backend of the process share the same X11 connection and the same
+     *  event and drawing thread. A backend can be closed or destroyed from any thread, including
+     *  its own event handlers and closures : on the ui thread, the window is closed immediately.
      */
     class x11_backend : public view_backend {
+        friend class x11_window;
+        friend class x11_runtime;
 
     public:
-        x11_backend(widget& root, float pixel_per_unit);
-        virtual ~x11_backend() = default;
+        /**
+         *  \param renderer requested NanoVG renderer : fallback on OpenGL 2 if a core profile is not available
+         */
+        x11_backend(widget& root, float pixel_per_unit, gl_version renderer = gl_version::gl2);
+        virtual ~x11_backend();
 
         void create_window(const std::string& title, void *parent = nullptr) override;
         void wait_window_thread() override;
         void close_window() override;
         bool windows_is_open() const noexcept override;
+        void post_to_ui_thread(std::function<void()> task) override;
+
+        void set_vsync(vsync_mode mode) override;
+        void set_max_fps(float fps) override;
+        void set_motion_compression(bool enabled) override;
+        frame_statistics get_frame_statistics() const override;
+        input_latency_statistics get_input_latency_statistics() const override;
 
         // no need to implement vst2_char_input as keyboard event are retrieved by vst plgin directly from X11.
     private:
         typedef unsigned long Window;
-        static void _window_proc(x11_backend *self, Window parent, const std::string& title);
 
-        std::thread _window_thread{};
-        bool _running{false};
+        //  Executed by the runtime thread
+        void _open_window(Window parent, const std::string& title);
+        void _destroy_window();
+
+        const gl_version _renderer;
+        std::shared_ptr<x11_runtime> _runtime;
+
+        //  Only accessed from the runtime thread
+        std::unique_ptr<x11_window> _window{};
+
+        //  Window state, as seen by the other threads
+        std::atomic<bool> _running{false};
+        std::mutex _state_mutex{};
+        std::condition_variable _state_condition{};
+        bool _window_open{false};
+
+        //  Closures and damaged areas posted from other threads
+        ui_task_queue _ui_queue{};
+
+        //  Frame pacing
+        frame_scheduler _scheduler{};
+        std::atomic<vsync_mode> _vsync{vsync_mode::on};
+        std::atomic<bool> _motion_compression{true};
+
+        //  Input to photon latency measurement
+        input_latency_tracker _latency{};
+
+        //  Expire with the backend : tell the closures posted to the runtime whether it is still alive
+        std::shared_ptr<void> _lifetime{std::make_shared<char>()};
     };
 
 }
 
-#endif
\ No newline at end of file
+#endif
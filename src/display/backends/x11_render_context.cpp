@@ -0,0 +1,167 @@
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+
+#include "x11_render_context.h"
+#include "internal_fonts/internal_fonts.h"
+
+namespace View {
+
+    static int ignore_x_error(Display*, XErrorEvent*)
+    {
+        return 0;
+    }
+
+    x11_render_context::current_scope::current_scope(x11_render_context& context, Window window)
+    :   _context{context}
+    {
+        glXMakeCurrent(_context._display, window, _context._glx);
+    }
+
+    x11_render_context::current_scope::~current_scope()
+    {
+        //  The window may be destroyed once the scope is left
+        glXMakeCurrent(_context._display, None, nullptr);
+    }
+
+    std::shared_ptr<x11_render_context> x11_render_context::acquire(gl_version renderer)
+    {
+        //  Only called by the runtime thread, when a window is opened
+        static std::weak_ptr<x11_render_context> instance{};
+        auto context = instance.lock();
+
+        if (!context) {
+            context = std::shared_ptr<x11_render_context>{new x11_render_context{renderer}};
+            instance = context;
+        }
+
+        return context;
+    }
+
+    x11_render_context::x11_render_context(gl_version renderer)
+    :   _renderer{renderer}
+    {
+        //  The context has its own connection : it does not depend on the runtime one lifetime
+        _display = XOpenDisplay(nullptr /* display name*/);
+
+        if (_display == nullptr)
+            throw std::runtime_error("Unable to open X display");
+
+        //  A framebuffer config is needed to create a core profile context
+        const int fb_attributes[] = {
+            GLX_X_RENDERABLE, True,
+            GLX_DRAWABLE_TYPE, GLX_WINDOW_BIT,
+            GLX_RENDER_TYPE, GLX_RGBA_BIT,
+            GLX_DOUBLEBUFFER, True,
+            GLX_RED_SIZE, 8,
+            GLX_GREEN_SIZE, 8,
+            GLX_BLUE_SIZE, 8,
+            GLX_DEPTH_SIZE, 24,
+            None};
+
+        int fb_config_count = 0;
+        GLXFBConfig *fb_configs = glXChooseFBConfig(_display, DefaultScreen(_display), fb_attributes, &fb_config_count);
+
+        if (fb_configs == nullptr || fb_config_count == 0) {
+            XCloseDisplay(_display);
+            throw std::runtime_error("Unable to find a GLX framebuffer config");
+        }
+
+        _fb_config = fb_configs[0];
+        XFree(fb_configs);
+
+        XVisualInfo *visual_info = glXGetVisualFromFBConfig(_display, _fb_config);
+        _visual_id = visual_info->visualid;
+
+        //  A compatibility context can not be made current without a drawable
+        const auto root_window = DefaultRootWindow(_display);
+        XSetWindowAttributes xattributs;
+        std::memset(&xattributs, 0, sizeof(xattributs));
+        _colormap = XCreateColormap(_display, root_window, visual_info->visual, AllocNone);
+        xattributs.colormap = _colormap;
+
+        _helper_window =
+            XCreateWindow(
+                _display, root_window,
+                0, 0, 1, 1, 0,
+                visual_info->depth, InputOutput,
+                visual_info->visual,
+                CWColormap, &xattributs);
+
+        XFree(visual_info);
+
+        //  GLX + OpenGL
+        _glx = _create_glx_context();
+
+        auto scope = make_current(_helper_window);
+        glewExperimental = GL_TRUE;     //  Needed by glew with a core profile
+        glewInit();
+        glEnable(GL_STENCIL_TEST);
+        glClearColor(0.0, 0.0, 0.0, 1.0);
+
+        //  NanoVG
+        _vg = create_nanovg_gl_context(_renderer);
+
+        //  Intitialize internals fonts, once for every windows
+        create_roboto_regular_font(_vg);
+        create_roboto_bold_font(_vg);
+    }
+
+    x11_render_context::~x11_render_context()
+    {
+        {
+            auto scope = make_current(_helper_window);
+            delete_nanovg_gl_context(_vg, _renderer);
+        }
+
+        glXDestroyContext(_display, _glx);
+        XDestroyWindow(_display, _helper_window);
+        XFreeColormap(_display, _colormap);
+        XCloseDisplay(_display);
+    }
+
+    bool x11_render_context::has_extension(const std::string& name) const
+    {
+        std::istringstream extensions{glXQueryExtensionsString(_display, DefaultScreen(_display))};
+        std::string extension;
+
+        while (extensions >> extension) {
+            if (extension == name)
+                return true;
+        }
+
+        return false;
+    }
+
+    GLXContext x11_render_context::_create_glx_context()
+    {
+        if (_renderer == gl_version::gl3 && gl_renderer_available(gl_version::gl3) &&
+            has_extension("GLX_ARB_create_context_profile")) {
+            const auto create_context_attribs = reinterpret_cast<PFNGLXCREATECONTEXTATTRIBSARBPROC>(
+                glXGetProcAddress(reinterpret_cast<const GLubyte*>("glXCreateContextAttribsARB")));
+
+            const int context_attributes[] = {
+                GLX_CONTEXT_MAJOR_VERSION_ARB, 3,
+                GLX_CONTEXT_MINOR_VERSION_ARB, 2,
+                GLX_CONTEXT_PROFILE_MASK_ARB, GLX_CONTEXT_CORE_PROFILE_BIT_ARB,
+                None};
+
+            //  An unsupported version raise an X error, which would terminate the process
+            const auto previous_handler = XSetErrorHandler(ignore_x_error);
+            const auto context = create_context_attribs(_display, _fb_config, nullptr, True, context_attributes);
+            XSync(_display, False);
+            XSetErrorHandler(previous_handler);
+
+            if (context != nullptr)
+                return context;
+        }
+
+        //  Compatibility context : use the OpenGL 2 renderer
+        _renderer = gl_version::gl2;
+        return glXCreateNewContext(_display, _fb_config, GLX_RGBA_TYPE, nullptr, True);
+    }
+
+}
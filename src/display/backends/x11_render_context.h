@@ -0,0 +1,91 @@
+#ifndef VIEW_X11_RENDER_CONTEXT_H_
+#define VIEW_X11_RENDER_CONTEXT_H_
+
+#include <memory>
+#include <string>
+
+#include <GL/glew.h>
+#include <GL/glx.h>
+
+#include "display/common/gl_renderer.h"
+
+namespace View {
+
+    /**
+     *  \class x11_render_context
+     *  \brief OpenGL and NanoVG context shared by every window of the process
+     *  \details Fonts are loaded once, and the glyph atlas and NanoVG images are shared
+     *  by all windows. The context is reference counted : it is created with the first
+     *  window and destroyed with the last one. Every window is created, drawn and destroyed
+     *  by the x11_runtime thread, so the context is only ever used by this thread and needs
+     *  no locking : it must be acquired and used on the runtime thread only.
+     */
+    class x11_render_context {
+    public:
+
+        /**
+         *  \class current_scope
+         *  \brief Make the context current on a window for the scope lifetime
+         *  \details The context is released at the end of the scope, so that it is never left
+         *  current on a window about to be destroyed.
+         */
+        class current_scope {
+        public:
+            current_scope(x11_render_context& context, Window window);
+            current_scope(const current_scope&) = delete;
+            ~current_scope();
+
+        private:
+            x11_render_context& _context;
+        };
+
+        /**
+         *  \brief Get the process render context, creating it if needed (runtime thread only)
+         *  \param renderer requested renderer, only used when the context is created
+         */
+        static std::shared_ptr<x11_render_context> acquire(gl_version renderer);
+
+        x11_render_context(const x11_render_context&) = delete;
+        ~x11_render_context();
+
+        /**
+         *  \brief Make the context current on a window (created with visual_id)
+         */
+        current_scope make_current(Window window) { return current_scope{*this, window}; }
+
+        /**
+         *  \brief Connection used for every GLX call (drawables are shared by every connection)
+         */
+        Display *display() const noexcept { return _display; }
+
+        /**
+         *  \brief Windows drawn with this context must be created with this visual
+         */
+        VisualID visual_id() const noexcept { return _visual_id; }
+
+        /**
+         *  \brief NanoVG context, to be used only in a current scope
+         */
+        NVGcontext *nvg() const noexcept { return _vg; }
+
+        gl_version renderer() const noexcept { return _renderer; }
+
+        bool has_extension(const std::string& name) const;
+
+    private:
+        explicit x11_render_context(gl_version renderer);
+        GLXContext _create_glx_context();
+
+        Display *_display{nullptr};
+        GLXFBConfig _fb_config{};
+        VisualID _visual_id{};
+        Colormap _colormap{};
+        Window _helper_window{};    // Drawable used when no window is available
+        gl_version _renderer;
+        GLXContext _glx{};
+        NVGcontext *_vg{nullptr};
+    };
+
+}
+
+#endif
@@ -0,0 +1,104 @@
+
+#include "damage_region.h"
+
+namespace View {
+
+    static long surface(const damage_region::area& a) noexcept
+    {
+        return static_cast<long>(a.width()) * static_cast<long>(a.height());
+    }
+
+    static long overlap_surface(const damage_region::area& a, const damage_region::area& b) noexcept
+    {
+        damage_region::area intersection;
+        return a.intersect(b, intersection) ? surface(intersection) : 0l;
+    }
+
+    //  Wasted surface (redrawn but not damaged) when a and b are replaced by their bounding box
+    static long merge_waste(const damage_region::area& a, const damage_region::area& b) noexcept
+    {
+        const auto covered = surface(a) + surface(b) - overlap_surface(a, b);
+        return surface(a.bounding(b)) - covered;
+    }
+
+    void damage_region::add(const area& a)
+    {
+        if (a.width() <= 0 || a.height() <= 0)
+            return;
+
+        auto current = a;
+
+        for (auto it = _rects.begin(); it != _rects.end();) {
+            if (it->contains(current)) {
+                //  Already damaged
+                return;
+            }
+            else if (current.contains(*it) || _should_merge(*it, current)) {
+                //  Absorb this rectangle and check again the others against the merged one
+                current = current.bounding(*it);
+                _rects.erase(it);
+                it = _rects.begin();
+            }
+            else {
+                ++it;
+            }
+        }
+
+        _rects.push_back(current);
+
+        if (_rects.size() > max_rect_count)
+            _merge_cheapest_pair();
+    }
+
+    void damage_region::add(const damage_region& other)
+    {
+        for (const auto& a : other)
+            add(a);
+    }
+
+    damage_region::area damage_region::bounding() const noexcept
+    {
+        auto result = _rects.front();
+        for (const auto& a : _rects)
+            result = result.bounding(a);
+        return result;
+    }
+
+    bool damage_region::_should_merge(const area& a, const area& b) noexcept
+    {
+        //  Small amount of pixels that it is always worth to redraw rather than splitting a frame
+        constexpr long min_waste = 32l * 32l;
+
+        //  Overlapping rectangles are always merged : rectangles in the region are disjoint
+        if (a.overlap(b))
+            return true;
+
+        return merge_waste(a, b) <= std::max(min_waste, (surface(a) + surface(b)) / 2l);
+    }
+
+    void damage_region::_merge_cheapest_pair()
+    {
+        auto best_first = 0u;
+        auto best_second = 1u;
+        auto best_waste = merge_waste(_rects[0], _rects[1]);
+
+        for (auto i = 0u; i < _rects.size(); ++i) {
+            for (auto j = i + 1u; j < _rects.size(); ++j) {
+                const auto waste = merge_waste(_rects[i], _rects[j]);
+                if (waste < best_waste) {
+                    best_waste = waste;
+                    best_first = i;
+                    best_second = j;
+                }
+            }
+        }
+
+        const auto merged = _rects[best_first].bounding(_rects[best_second]);
+        _rects.erase(_rects.begin() + best_second);
+        _rects.erase(_rects.begin() + best_first);
+
+        //  The merged rectangle may now overlap with others
+        add(merged);
+    }
+
+}
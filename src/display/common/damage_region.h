@@ -0,0 +1,60 @@
+#ifndef VIEW_DAMAGE_REGION_H_
+#define VIEW_DAMAGE_REGION_H_
+
+#include <vector>
+
+#include "widget/rectangle.h"
+
+namespace View {
+
+    /**
+     *  \class damage_region
+     *  \brief Accumulate the display areas that must be redrawn (pixel coordinates)
+     *  \details The region is kept as a small set of rectangles. Two rectangles are merged
+     *  only when their bounding box does not cover much more than the rectangles themselves,
+     *  so that two small far apart updates are redrawn separately instead of as one huge area.
+     *  Rectangles in the region never overlap : overlapping areas are merged when added, so that
+     *  each pixel of the region is cleared and redrawn only once.
+     */
+    class damage_region {
+    public:
+        using area = rectangle<int>;
+
+        /**
+         *  \brief Maximum number of rectangles : beyond, the cheapest pair is merged
+         */
+        static constexpr auto max_rect_count = 8u;
+
+        /**
+         *  \brief Add an area to the region
+         */
+        void add(const area& a);
+
+        /**
+         *  \brief Add every rectangle of an other region
+         */
+        void add(const damage_region& other);
+
+        void clear() noexcept { _rects.clear(); }
+        bool empty() const noexcept { return _rects.empty(); }
+        auto size() const noexcept { return _rects.size(); }
+
+        /**
+         *  \brief Return the bounding box of the whole region
+         *  \note the region must not be empty
+         */
+        area bounding() const noexcept;
+
+        auto begin() const noexcept { return _rects.begin(); }
+        auto end() const noexcept { return _rects.end(); }
+
+    private:
+        static bool _should_merge(const area& a, const area& b) noexcept;
+        void _merge_cheapest_pair();
+
+        std::vector<area> _rects{};
+    };
+
+}
+
+#endif
@@ -0,0 +1,105 @@
+
+#include <algorithm>
+
+#include "frame_scheduler.h"
+
+namespace View {
+
+    frame_scheduler::frame_scheduler(float max_fps)
+    :   _max_fps{max_fps}
+    {
+    }
+
+    void frame_scheduler::set_max_fps(float fps) noexcept
+    {
+        _max_fps.store(std::max(0.f, fps));
+    }
+
+    float frame_scheduler::max_fps() const noexcept
+    {
+        return _max_fps.load();
+    }
+
+    void frame_scheduler::set_refresh_interval(clock::duration interval) noexcept
+    {
+        _refresh_interval.store(interval.count());
+    }
+
+    frame_scheduler::clock::duration frame_scheduler::time_until_next_frame(clock::time_point now) const noexcept
+    {
+        //  With vsync, the windows which are not synchronized are paced to the display refresh
+        const auto next_frame = _last_frame_begin + _frame_budget();
+        return now >= next_frame ? clock::duration::zero() : next_frame - now;
+    }
+
+    void frame_scheduler::begin_frame() noexcept
+    {
+        _frame_begin = clock::now();
+        _last_frame_begin = _frame_begin;
+    }
+
+    void frame_scheduler::end_draw() noexcept
+    {
+        _draw_end = clock::now();
+    }
+
+    void frame_scheduler::end_frame() noexcept
+    {
+        using std::chrono::duration_cast;
+
+        const auto frame_end = clock::now();
+        const auto draw_time = duration_cast<frame_statistics::duration>(_draw_end - _frame_begin);
+        const auto swap_time = duration_cast<frame_statistics::duration>(frame_end - _draw_end);
+        const auto budget = duration_cast<frame_statistics::duration>(_frame_budget());
+
+        std::lock_guard<std::mutex> lock{_statistics_mutex};
+        auto& s = _statistics;
+
+        s.frame_count++;
+        s.frame_budget = budget;
+
+        if (budget.count() > 0 && draw_time + swap_time > budget)
+            s.missed_deadline_count++;
+
+        _total_draw_time += draw_time;
+        s.last_draw_time = draw_time;
+        s.average_draw_time = _total_draw_time / s.frame_count;
+        s.max_draw_time = std::max(s.max_draw_time, draw_time);
+
+        _total_swap_time += swap_time;
+        s.last_swap_time = swap_time;
+        s.average_swap_time = _total_swap_time / s.frame_count;
+        s.max_swap_time = std::max(s.max_swap_time, swap_time);
+    }
+
+    frame_statistics frame_scheduler::statistics() const
+    {
+        std::lock_guard<std::mutex> lock{_statistics_mutex};
+        return _statistics;
+    }
+
+    void frame_scheduler::reset_statistics()
+    {
+        std::lock_guard<std::mutex> lock{_statistics_mutex};
+        _statistics = frame_statistics{};
+        _total_draw_time = {};
+        _total_swap_time = {};
+    }
+
+    frame_scheduler::clock::duration frame_scheduler::_frame_interval() const noexcept
+    {
+        const auto fps = _max_fps.load();
+
+        if (fps > 0.f)
+            return std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>{1.f / fps});
+        else
+            return clock::duration::zero();
+    }
+
+    frame_scheduler::clock::duration frame_scheduler::_frame_budget() const noexcept
+    {
+        //  With vsync, a frame can not be presented faster than the display refresh
+        return std::max(_frame_interval(), clock::duration{_refresh_interval.load()});
+    }
+
+}
@@ -0,0 +1,106 @@
+#ifndef VIEW_FRAME_SCHEDULER_H_
+#define VIEW_FRAME_SCHEDULER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace View {
+
+    /**
+     *  \brief Synchronization of the buffer swaps with the display refresh
+     */
+    enum class vsync_mode {
+        off,        /**< Swap as soon as the frame is drawn */
+        on,         /**< Wait for the vertical blank */
+        adaptive    /**< Wait for the vertical blank, unless the frame is late (tear instead of stalling) */
+    };
+
+    /**
+     *  \brief Frame timing measurements
+     */
+    struct frame_statistics {
+        using duration = std::chrono::microseconds;
+
+        std::uint64_t frame_count{0u};
+        std::uint64_t missed_deadline_count{0u};    /**< Frames whose draw + swap took longer than the frame budget */
+
+        duration frame_budget{};                    /**< Maximum time a frame should take */
+
+        duration last_draw_time{};                  /**< Cpu time spent building the frame */
+        duration average_draw_time{};
+        duration max_draw_time{};
+
+        duration last_swap_time{};                  /**< Time spent presenting the frame (include vsync wait) */
+        duration average_swap_time{};
+        duration max_swap_time{};
+    };
+
+    /**
+     *  \class frame_scheduler
+     *  \brief Decide when the next frame can be drawn and measure frame timings
+     *  \details Damage produced between two frames is accumulated by the caller and
+     *  drawn at once when the scheduler allows it. Frame limit and statistics
+     *  can be accessed from any thread, frame methods are called by the drawing thread.
+     */
+    class frame_scheduler {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        static constexpr auto default_max_fps = 120.f;
+
+        explicit frame_scheduler(float max_fps = default_max_fps);
+
+        /**
+         *  \brief Limit the frame rate (for example for a background window)
+         *  \param fps maximum frame per second, 0 to disable the limit
+         */
+        void set_max_fps(float fps) noexcept;
+        float max_fps() const noexcept;
+
+        /**
+         *  \brief Set the display refresh interval : when vsync is enabled, frames are not drawn
+         *  faster than the display refresh, nor than max_fps
+         *  \param interval zero if unknown or if vsync is disabled
+         */
+        void set_refresh_interval(clock::duration interval) noexcept;
+
+        /**
+         *  \brief Return how long to wait before drawing the next frame (zero if a frame can be drawn now)
+         *  \details Frames are spaced by the longest of the max_fps interval and the refresh interval
+         */
+        clock::duration time_until_next_frame(clock::time_point now) const noexcept;
+
+        /**
+         *  \brief Frame timing measurement, in this order
+         */
+        void begin_frame() noexcept;
+        void end_draw() noexcept;
+        void end_frame() noexcept;
+
+        frame_statistics statistics() const;
+        void reset_statistics();
+
+    private:
+        clock::duration _frame_interval() const noexcept;
+        clock::duration _frame_budget() const noexcept;
+
+        std::atomic<float> _max_fps;
+        std::atomic<clock::duration::rep> _refresh_interval{0};
+
+        //  Drawing thread only
+        clock::time_point _last_frame_begin{};
+        clock::time_point _frame_begin{};
+        clock::time_point _draw_end{};
+
+        //  Accumulated statistics
+        mutable std::mutex _statistics_mutex{};
+        frame_statistics _statistics{};
+        frame_statistics::duration _total_draw_time{};
+        frame_statistics::duration _total_swap_time{};
+    };
+
+}
+
+#endif
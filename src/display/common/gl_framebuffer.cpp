@@ -0,0 +1,111 @@
+
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include "gl_framebuffer.h"
+
+namespace View {
+
+    gl_framebuffer::~gl_framebuffer()
+    {
+        release();
+    }
+
+    bool gl_framebuffer::resize(unsigned int width, unsigned int height)
+    {
+        release();
+
+        _width = width;
+        _height = height;
+
+        //  A 0 sized attachment is never complete : wait for a real size
+        if (width == 0u || height == 0u)
+            return true;
+
+        glGenFramebuffers(1, &_framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+
+        //  Color
+        glGenTextures(1, &_color_texture);
+        glBindTexture(GL_TEXTURE_2D, _color_texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0u);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _color_texture, 0);
+
+        //  Stencil is required by NanoVG
+        glGenRenderbuffers(1, &_stencil_buffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, _stencil_buffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0u);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, _stencil_buffer);
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            glBindFramebuffer(GL_FRAMEBUFFER, 0u);
+            release();
+            _width = _height = 0u;
+            return false;
+        }
+
+        //  Start from a cleared content
+        glClearColor(0.0, 0.0, 0.0, 1.0);
+        glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0u);
+        return true;
+    }
+
+    void gl_framebuffer::release()
+    {
+        if (_framebuffer != 0u) {
+            glDeleteRenderbuffers(1, &_stencil_buffer);
+            glDeleteTextures(1, &_color_texture);
+            glDeleteFramebuffers(1, &_framebuffer);
+            _framebuffer = _color_texture = _stencil_buffer = 0u;
+        }
+    }
+
+    void gl_framebuffer::abandon() noexcept
+    {
+        _framebuffer = _color_texture = _stencil_buffer = 0u;
+    }
+
+    void gl_framebuffer::bind() const
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+        glViewport(0, 0, _width, _height);
+    }
+
+    void gl_framebuffer::bind_default()
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0u);
+    }
+
+    void gl_framebuffer::blit_to_default() const
+    {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, _framebuffer);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0u);
+        glBlitFramebuffer(
+            0, 0, _width, _height,
+            0, 0, _width, _height,
+            GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0u);
+    }
+
+    void gl_framebuffer::read_pixels(std::uint8_t *pixels) const
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, _width, _height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0u);
+    }
+
+}
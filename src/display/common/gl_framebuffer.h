@@ -0,0 +1,81 @@
+#ifndef VIEW_GL_FRAMEBUFFER_H_
+#define VIEW_GL_FRAMEBUFFER_H_
+
+#include <cstdint>
+
+namespace View {
+
+    /**
+     *  \class gl_framebuffer
+     *  \brief An OpenGL framebuffer object with a color texture and a stencil buffer (as required by NanoVG)
+     *  \details Every method must be called with the owning OpenGL context current.
+     */
+    class gl_framebuffer {
+    public:
+        gl_framebuffer() = default;
+        gl_framebuffer(const gl_framebuffer&) = delete;
+        ~gl_framebuffer();
+
+        /**
+         *  \brief (Re)allocate the framebuffer storage. Previous content is lost
+         *  \details Nothing is allocated while the width or the height is 0 (minimized window) :
+         *  the framebuffer is then empty.
+         *  \return false if the storage could not be allocated : the framebuffer is left empty
+         */
+        bool resize(unsigned int width, unsigned int height);
+
+        /**
+         *  \brief Return true if no storage is allocated : there is nothing to draw into or to present
+         */
+        bool empty() const noexcept { return _framebuffer == 0u; }
+
+        /**
+         *  \brief Release the OpenGL objects
+         */
+        void release();
+
+        /**
+         *  \brief Forget the OpenGL objects, that were destroyed with their context
+         */
+        void abandon() noexcept;
+
+        /**
+         *  \brief Draw into this framebuffer
+         */
+        void bind() const;
+
+        /**
+         *  \brief Draw into the default (window) framebuffer
+         */
+        static void bind_default();
+
+        /**
+         *  \brief Copy the whole content into the default framebuffer, whose content may have been lost
+         */
+        void blit_to_default() const;
+
+        /**
+         *  \brief Read back the content
+         *  \param pixels destination, 4 * width * height bytes, rows ordered from bottom to top
+         */
+        void read_pixels(std::uint8_t *pixels) const;
+
+        unsigned int width() const noexcept { return _width; }
+        unsigned int height() const noexcept { return _height; }
+
+        /**
+         *  \brief OpenGL color texture name
+         */
+        unsigned int texture() const noexcept { return _color_texture; }
+
+    private:
+        unsigned int _framebuffer{0u};
+        unsigned int _color_texture{0u};
+        unsigned int _stencil_buffer{0u};
+        unsigned int _width{0u};
+        unsigned int _height{0u};
+    };
+
+}
+
+#endif
@@ -0,0 +1,142 @@
+
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "gl_renderer.h"
+
+//  Only for the NVGcreateFlags declaration : no implementation is compiled here
+#include "nanovg_gl.h"
+
+namespace View {
+
+    //  Implemented in gl_renderer_gl2.cpp and gl_renderer_gl3.cpp
+    NVGcontext *create_nanovg_gl2_context(int flags);
+    void delete_nanovg_gl2_context(NVGcontext *vg);
+    int create_nanovg_gl2_image(NVGcontext *vg, unsigned int texture, int width, int height, int image_flags);
+#ifdef NANOVG_WITH_GL3
+    NVGcontext *create_nanovg_gl3_context(int flags);
+    void delete_nanovg_gl3_context(NVGcontext *vg);
+    int create_nanovg_gl3_image(NVGcontext *vg, unsigned int texture, int width, int height, int image_flags);
+#endif
+
+    namespace {
+
+        struct context_info {
+            gl_version version;
+            std::uint64_t id;
+        };
+
+        //  Renderer used by each living context
+        struct context_registry {
+            std::mutex mutex{};
+            std::unordered_map<NVGcontext*, context_info> contexts{};
+            std::uint64_t next_id{1u};
+        };
+
+        context_registry& registry()
+        {
+            static context_registry instance{};
+            return instance;
+        }
+
+        void register_context(NVGcontext *vg, gl_version version)
+        {
+            auto& r = registry();
+            std::lock_guard<std::mutex> lock{r.mutex};
+            r.contexts[vg] = context_info{version, r.next_id++};
+        }
+
+        void unregister_context(NVGcontext *vg)
+        {
+            auto& r = registry();
+            std::lock_guard<std::mutex> lock{r.mutex};
+            r.contexts.erase(vg);
+        }
+
+        bool find_context(NVGcontext *vg, context_info& info)
+        {
+            auto& r = registry();
+            std::lock_guard<std::mutex> lock{r.mutex};
+            const auto it = r.contexts.find(vg);
+
+            if (it == r.contexts.end())
+                return false;
+
+            info = it->second;
+            return true;
+        }
+
+    }
+
+    static int nanovg_flags() noexcept
+    {
+#ifdef NDEBUG
+        return NVG_ANTIALIAS | NVG_STENCIL_STROKES;
+#else
+        return NVG_ANTIALIAS | NVG_STENCIL_STROKES | NVG_DEBUG;
+#endif
+    }
+
+    bool gl_renderer_available(gl_version version) noexcept
+    {
+        return version == gl_version::gl2
+#ifdef NANOVG_WITH_GL3
+            || version == gl_version::gl3
+#endif
+            ;
+    }
+
+    NVGcontext *create_nanovg_gl_context(gl_version version)
+    {
+        NVGcontext *vg = nullptr;
+
+        switch (version) {
+#ifdef NANOVG_WITH_GL3
+        case gl_version::gl3: vg = create_nanovg_gl3_context(nanovg_flags()); break;
+#endif
+        case gl_version::gl2: vg = create_nanovg_gl2_context(nanovg_flags()); break;
+        default:
+            throw std::runtime_error("gl_renderer : the OpenGL 3 renderer is not available in this build");
+        }
+
+        if (vg != nullptr)
+            register_context(vg, version);
+
+        return vg;
+    }
+
+    void delete_nanovg_gl_context(NVGcontext *vg, gl_version version)
+    {
+        unregister_context(vg);
+
+        switch (version) {
+#ifdef NANOVG_WITH_GL3
+        case gl_version::gl3: delete_nanovg_gl3_context(vg); break;
+#endif
+        default: delete_nanovg_gl2_context(vg); break;
+        }
+    }
+
+    std::uint64_t nanovg_gl_context_id(NVGcontext *vg) noexcept
+    {
+        context_info info;
+        return find_context(vg, info) ? info.id : 0u;
+    }
+
+    int create_nanovg_image_from_texture(NVGcontext *vg, unsigned int texture, int width, int height, int image_flags)
+    {
+        context_info info;
+
+        if (!find_context(vg, info))
+            throw std::runtime_error("gl_renderer : unknown NanoVG context");
+
+        switch (info.version) {
+#ifdef NANOVG_WITH_GL3
+        case gl_version::gl3: return create_nanovg_gl3_image(vg, texture, width, height, image_flags);
+#endif
+        default: return create_nanovg_gl2_image(vg, texture, width, height, image_flags);
+        }
+    }
+
+}
@@ -0,0 +1,53 @@
+#ifndef VIEW_GL_RENDERER_H_
+#define VIEW_GL_RENDERER_H_
+
+#include <cstdint>
+
+#include <nanovg.h>
+
+namespace View {
+
+    /**
+     *  \brief NanoVG OpenGL renderer
+     */
+    enum class gl_version {
+        gl2,    /**< OpenGL 2 : compatibility context, always available */
+        gl3     /**< OpenGL 3.2 core profile : uniform buffers, fewer state changes per draw call */
+    };
+
+    /**
+     *  \brief Return true if the NanoVG renderer was built in the library (see the NANOVG_WITH_GL3 option)
+     */
+    bool gl_renderer_available(gl_version version) noexcept;
+
+    /**
+     *  \brief Create a NanoVG context drawing with the OpenGL context current on the calling thread
+     *  \note The NanoVG OpenGL implementations are compiled each in a single translation unit,
+     *  so that several backends can be built in the same library.
+     *  OpenGL errors are checked after each draw call in debug builds only.
+     */
+    NVGcontext *create_nanovg_gl_context(gl_version version = gl_version::gl2);
+
+    /**
+     *  \brief Delete a NanoVG context created by create_nanovg_gl_context
+     */
+    void delete_nanovg_gl_context(NVGcontext *vg, gl_version version = gl_version::gl2);
+
+    /**
+     *  \brief Return an identifier unique to a NanoVG context during the process life, or 0 if it was deleted
+     *  \details Allow to detect that OpenGL objects were destroyed with their context, even if a new
+     *  context was created at the same address.
+     */
+    std::uint64_t nanovg_gl_context_id(NVGcontext *vg) noexcept;
+
+    /**
+     *  \brief Wrap an OpenGL texture into a NanoVG image
+     *  \param vg a context created by create_nanovg_gl_context
+     *  \param image_flags NanoVG image flags (the texture is deleted with the image unless NVG_IMAGE_NODELETE is set)
+     *  \return the image handle, 0 on failure
+     */
+    int create_nanovg_image_from_texture(NVGcontext *vg, unsigned int texture, int width, int height, int image_flags);
+
+}
+
+#endif
@@ -0,0 +1,33 @@
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include <nanovg.h>
+
+//  The NanoVG OpenGL 2 renderer is implemented (with static functions) in this translation unit only
+#define NANOVG_GL2_IMPLEMENTATION
+#include "nanovg_gl.h"
+
+namespace View {
+
+    NVGcontext *create_nanovg_gl2_context(int flags)
+    {
+        return nvgCreateGL2(flags);
+    }
+
+    void delete_nanovg_gl2_context(NVGcontext *vg)
+    {
+        nvgDeleteGL2(vg);
+    }
+
+    int create_nanovg_gl2_image(NVGcontext *vg, unsigned int texture, int width, int height, int image_flags)
+    {
+        return nvglCreateImageFromHandleGL2(vg, texture, width, height, image_flags);
+    }
+
+}
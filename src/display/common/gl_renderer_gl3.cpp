@@ -0,0 +1,33 @@
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include <nanovg.h>
+
+//  The NanoVG OpenGL 3 renderer is implemented (with static functions) in this translation unit only
+#define NANOVG_GL3_IMPLEMENTATION
+#include "nanovg_gl.h"
+
+namespace View {
+
+    NVGcontext *create_nanovg_gl3_context(int flags)
+    {
+        return nvgCreateGL3(flags);
+    }
+
+    void delete_nanovg_gl3_context(NVGcontext *vg)
+    {
+        nvgDeleteGL3(vg);
+    }
+
+    int create_nanovg_gl3_image(NVGcontext *vg, unsigned int texture, int width, int height, int image_flags)
+    {
+        return nvglCreateImageFromHandleGL3(vg, texture, width, height, image_flags);
+    }
+
+}
@@ -0,0 +1,182 @@
+
+#include <algorithm>
+#include <cmath>
+
+#include "input_latency.h"
+
+namespace View {
+
+    void latency_histogram::add(duration d) noexcept
+    {
+        const auto us = static_cast<std::uint64_t>(std::max<duration::rep>(0, d.count()));
+
+        //  Index of the highest bit set
+        unsigned int index = 0u;
+        while (index + 1u < bucket_count && (us >> (index + 1u)) != 0u)
+            index++;
+
+        _buckets[index]++;
+        _count++;
+        _total += d;
+        _max = std::max(_max, d);
+    }
+
+    latency_histogram::duration latency_histogram::mean() const noexcept
+    {
+        return _count == 0u ? duration{} : _total / static_cast<duration::rep>(_count);
+    }
+
+    latency_histogram::duration latency_histogram::percentile(float p) const noexcept
+    {
+        if (_count == 0u)
+            return duration{};
+
+        const auto rank = static_cast<std::uint64_t>(std::ceil(std::clamp(p, 0.f, 1.f) * _count));
+        std::uint64_t accumulated = 0u;
+
+        for (auto i = 0u; i < bucket_count; ++i) {
+            accumulated += _buckets[i];
+            if (accumulated >= rank && accumulated > 0u)
+                return std::min(bucket_upper_bound(i), _max);
+        }
+
+        return _max;
+    }
+
+    latency_histogram::duration latency_histogram::bucket_upper_bound(unsigned int index) noexcept
+    {
+        return duration{duration::rep{1} << (index + 1u)};
+    }
+
+    void input_latency_tracker::begin_event(std::uint32_t server_time, clock::time_point received) noexcept
+    {
+        begin_event(_server_time_to_local(server_time, received));
+    }
+
+    void input_latency_tracker::begin_event(clock::time_point received) noexcept
+    {
+        //  The queued moves are dispatched before the event
+        begin_motion_dispatch();
+        _begin_dispatch(received, _in_event ? _pending[_dispatch_first].dispatch_begin : clock::now());
+    }
+
+    void input_latency_tracker::end_event() noexcept
+    {
+        if (_in_event) {
+            const auto now = clock::now();
+
+            for (auto i = _dispatch_first; i < _pending.size(); ++i)
+                _pending[i].dispatch_end = now;
+
+            _in_event = false;
+        }
+    }
+
+    void input_latency_tracker::queue_motion(std::uint32_t server_time, clock::time_point received) noexcept
+    {
+        const auto emitted = _server_time_to_local(server_time, received);
+
+        if (!_has_queued_motion) {
+            _queued_motion_emitted = emitted;
+            _has_queued_motion = true;
+        }
+    }
+
+    void input_latency_tracker::begin_motion_dispatch() noexcept
+    {
+        _in_event = false;
+
+        if (_has_queued_motion) {
+            _has_queued_motion = false;
+            _begin_dispatch(_queued_motion_emitted, clock::now());
+        }
+    }
+
+    void input_latency_tracker::discard_pending() noexcept
+    {
+        _pending.clear();
+        _in_event = false;
+        _has_queued_motion = false;
+    }
+
+    void input_latency_tracker::end_draw() noexcept
+    {
+        _draw_end = clock::now();
+    }
+
+    void input_latency_tracker::end_frame()
+    {
+        if (_pending.empty())
+            return;
+
+        using std::chrono::duration_cast;
+        using duration = latency_histogram::duration;
+
+        const auto frame_end = clock::now();
+        const auto swap_time = duration_cast<duration>(frame_end - _draw_end);
+
+        {
+            std::lock_guard<std::mutex> lock{_statistics_mutex};
+            auto& s = _statistics;
+
+            s.frame_count++;
+            s.swap.add(swap_time);
+
+            for (const auto& event : _pending) {
+                s.event_count++;
+                s.queueing.add(duration_cast<duration>(event.dispatch_begin - event.emitted));
+                s.dispatch.add(duration_cast<duration>(event.dispatch_end - event.dispatch_begin));
+                s.draw.add(duration_cast<duration>(_draw_end - event.dispatch_end));
+                s.total.add(duration_cast<duration>(frame_end - event.emitted));
+            }
+        }
+
+        _pending.clear();
+    }
+
+    void input_latency_tracker::_begin_dispatch(clock::time_point emitted, clock::time_point now) noexcept
+    {
+        if (_pending.size() >= max_pending_events)
+            return;
+
+        //  The first event of the dispatch
+        if (!_in_event) {
+            _dispatch_first = _pending.size();
+            _in_event = true;
+        }
+
+        _pending.push_back({emitted, now, now});
+    }
+
+    input_latency_statistics input_latency_tracker::statistics() const
+    {
+        std::lock_guard<std::mutex> lock{_statistics_mutex};
+        return _statistics;
+    }
+
+    void input_latency_tracker::reset_statistics()
+    {
+        std::lock_guard<std::mutex> lock{_statistics_mutex};
+        _statistics = input_latency_statistics{};
+    }
+
+    input_latency_tracker::clock::time_point input_latency_tracker::_server_time_to_local(
+        std::uint32_t server_time, clock::time_point received) noexcept
+    {
+        //  The server clock is not related to the local steady clock : the offset between them
+        //  is estimated as the smallest one observed, i.e. for the event that was received the fastest.
+        //  A much larger offset mean that the server clock has wrapped (every 49 days) : start again.
+        constexpr auto max_offset_drift = std::chrono::seconds{10};
+
+        const auto server = std::chrono::duration_cast<clock::duration>(std::chrono::milliseconds{server_time});
+        const auto offset = received.time_since_epoch() - server;
+
+        if (!_has_clock_offset || offset < _clock_offset || offset - _clock_offset > max_offset_drift) {
+            _clock_offset = offset;
+            _has_clock_offset = true;
+        }
+
+        return clock::time_point{server + _clock_offset};
+    }
+
+}
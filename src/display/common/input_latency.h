@@ -0,0 +1,150 @@
+#ifndef VIEW_INPUT_LATENCY_H_
+#define VIEW_INPUT_LATENCY_H_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace View {
+
+    /**
+     *  \class latency_histogram
+     *  \brief Distribution of durations, in power of two microsecond buckets
+     *  \details Bucket 0 count durations below 2 us, bucket i count durations in [2^i, 2^(i+1)) us.
+     *  The last bucket also count every longer duration.
+     */
+    class latency_histogram {
+    public:
+        using duration = std::chrono::microseconds;
+
+        static constexpr auto bucket_count = 24u;
+
+        void add(duration d) noexcept;
+
+        std::uint64_t count() const noexcept { return _count; }
+        std::uint64_t bucket(unsigned int index) const noexcept { return _buckets[index]; }
+
+        duration mean() const noexcept;
+        duration max() const noexcept { return _max; }
+
+        /**
+         *  \brief Return an upper bound of the given percentile
+         *  \param p percentile, in [0, 1]
+         */
+        duration percentile(float p) const noexcept;
+
+        /**
+         *  \brief Return the exclusive upper bound of a bucket
+         */
+        static duration bucket_upper_bound(unsigned int index) noexcept;
+
+    private:
+        std::array<std::uint64_t, bucket_count> _buckets{};
+        std::uint64_t _count{0u};
+        duration _total{};
+        duration _max{};
+    };
+
+    /**
+     *  \brief Latency of the input events, from their emission to the presentation of the frame showing them
+     */
+    struct input_latency_statistics {
+        std::uint64_t event_count{0u};  /**< Events that were presented in a frame */
+        std::uint64_t frame_count{0u};  /**< Frames that presented at least one event */
+
+        latency_histogram queueing{};   /**< From the event emission to the beginning of its dispatch */
+        latency_histogram dispatch{};   /**< Widget event handlers */
+        latency_histogram draw{};       /**< From the end of the dispatch to the end of the frame drawing (include frame pacing) */
+        latency_histogram swap{};       /**< Buffer swap, once per frame */
+        latency_histogram total{};      /**< From the event emission to the end of the buffer swap */
+    };
+
+    /**
+     *  \class input_latency_tracker
+     *  \brief Follow input events from their reception to the frame that present them
+     *  \details Events dispatched between two frames are kept pending and recorded when
+     *  the next frame is presented. When the display goes idle without drawing, the
+     *  pending events had no visible effect : they are discarded.
+     *  Mouse moves queued to be coalesced are dispatched later, with the next flush or the next
+     *  event : the moves coalesced in a dispatch count as one event, emitted with the oldest of them.
+     *  Statistics can be accessed from any thread, the other methods are called by the event thread.
+     */
+    class input_latency_tracker {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        /**
+         *  \brief Maximum number of events attributed to a frame (the oldest ones are kept)
+         */
+        static constexpr auto max_pending_events = 64u;
+
+        /**
+         *  \brief Surround the dispatch of an input event
+         *  \param server_time event timestamp given by the windows system, in milliseconds
+         *  \param received when the event was read by the event thread
+         */
+        void begin_event(std::uint32_t server_time, clock::time_point received) noexcept;
+        void begin_event(clock::time_point received) noexcept;
+        void end_event() noexcept;
+
+        /**
+         *  \brief A mouse move was queued, to be dispatched with the next coalesced moves
+         *  \param server_time event timestamp given by the windows system, in milliseconds
+         *  \param received when the event was read by the event thread
+         */
+        void queue_motion(std::uint32_t server_time, clock::time_point received) noexcept;
+
+        /**
+         *  \brief Surround the dispatch of the queued mouse moves, ended by end_event
+         *  \details Input events dispatched with begin_event also dispatch the queued moves first.
+         */
+        void begin_motion_dispatch() noexcept;
+
+        /**
+         *  \brief Drop the pending events : nothing will be drawn for them
+         */
+        void discard_pending() noexcept;
+
+        /**
+         *  \brief Frame presenting the pending events, in this order
+         */
+        void end_draw() noexcept;
+        void end_frame();
+
+        input_latency_statistics statistics() const;
+        void reset_statistics();
+
+    private:
+        struct event_timing {
+            clock::time_point emitted;
+            clock::time_point dispatch_begin;
+            clock::time_point dispatch_end;
+        };
+
+        clock::time_point _server_time_to_local(std::uint32_t server_time, clock::time_point received) noexcept;
+        void _begin_dispatch(clock::time_point emitted, clock::time_point now) noexcept;
+
+        //  Event thread only
+        std::vector<event_timing> _pending{};
+        std::size_t _dispatch_first{0u};        /**< First of the pending events being dispatched */
+        bool _in_event{false};
+        clock::time_point _draw_end{};
+
+        //  Oldest mouse move queued since the last dispatch
+        bool _has_queued_motion{false};
+        clock::time_point _queued_motion_emitted{};
+
+        //  Smallest observed difference between the local clock and the server clock
+        bool _has_clock_offset{false};
+        clock::duration _clock_offset{};
+
+        //  Accumulated statistics
+        mutable std::mutex _statistics_mutex{};
+        input_latency_statistics _statistics{};
+    };
+
+}
+
+#endif
@@ -0,0 +1,125 @@
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include "layer_surface.h"
+#include "gl_renderer.h"
+
+//  Only for the NVG_IMAGE_NODELETE declaration : no implementation is compiled here
+#include "nanovg_gl.h"
+
+namespace View {
+
+    namespace {
+
+        struct layer_renderer_registry {
+            std::mutex mutex{};
+            std::vector<layer_renderer> renderers{};
+        };
+
+        layer_renderer_registry& renderer_registry()
+        {
+            static layer_renderer_registry instance{};
+            return instance;
+        }
+
+    }
+
+    layer_surface::layer_surface(NVGcontext *vg)
+    :   _vg{vg},
+        _context_id{nanovg_gl_context_id(vg)}
+    {
+    }
+
+    layer_surface::~layer_surface()
+    {
+        if (valid()) {
+            if (_image != 0)
+                nvgDeleteImage(_vg, _image);
+            _framebuffer.release();
+        }
+        else {
+            //  The OpenGL objects were destroyed with their context
+            _framebuffer.abandon();
+        }
+    }
+
+    bool layer_surface::begin(unsigned int width, unsigned int height)
+    {
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &_previous_framebuffer);
+        glGetIntegerv(GL_VIEWPORT, _previous_viewport);
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, _previous_clear_color);
+
+        if (_framebuffer.empty() || width != _framebuffer.width() || height != _framebuffer.height()) {
+            if (_image != 0)
+                nvgDeleteImage(_vg, _image);
+            _image = 0;
+
+            //  resize bind the default framebuffer : the previous one is restored on failure
+            if (!_framebuffer.resize(width, height) || _framebuffer.empty()) {
+                glBindFramebuffer(GL_FRAMEBUFFER, _previous_framebuffer);
+                return false;
+            }
+
+            //  The texture belong to the framebuffer. NanoVG draw premultiplied colors,
+            //  and framebuffer rows are ordered from bottom to top.
+            _image = create_nanovg_image_from_texture(
+                _vg, _framebuffer.texture(), width, height,
+                NVG_IMAGE_NODELETE | NVG_IMAGE_FLIPY | NVG_IMAGE_PREMULTIPLIED);
+        }
+
+        _framebuffer.bind();
+        glClearColor(0.f, 0.f, 0.f, 0.f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+        nvgBeginFrame(_vg, width, height, 1.f);
+        return true;
+    }
+
+    void layer_surface::end()
+    {
+        nvgEndFrame(_vg);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, _previous_framebuffer);
+        glViewport(_previous_viewport[0], _previous_viewport[1], _previous_viewport[2], _previous_viewport[3]);
+        glClearColor(_previous_clear_color[0], _previous_clear_color[1], _previous_clear_color[2], _previous_clear_color[3]);
+    }
+
+    bool layer_surface::valid() const noexcept
+    {
+        return _context_id != 0u && nanovg_gl_context_id(_vg) == _context_id;
+    }
+
+    void register_layer_renderer(layer_renderer renderer)
+    {
+        auto& r = renderer_registry();
+        std::lock_guard<std::mutex> lock{r.mutex};
+
+        if (std::find(r.renderers.begin(), r.renderers.end(), renderer) == r.renderers.end())
+            r.renderers.push_back(renderer);
+    }
+
+    void render_layers(NVGcontext *vg)
+    {
+        std::vector<layer_renderer> renderers{};
+
+        {
+            auto& r = renderer_registry();
+            std::lock_guard<std::mutex> lock{r.mutex};
+            renderers = r.renderers;
+        }
+
+        for (auto renderer : renderers)
+            renderer(vg);
+    }
+
+}
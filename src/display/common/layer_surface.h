@@ -0,0 +1,76 @@
+#ifndef VIEW_LAYER_SURFACE_H_
+#define VIEW_LAYER_SURFACE_H_
+
+#include <cstdint>
+
+#include <nanovg.h>
+
+#include "gl_framebuffer.h"
+
+namespace View {
+
+    /**
+     *  \class layer_surface
+     *  \brief A framebuffer that NanoVG can draw into, and then use as an image
+     *  \details Every method must be called with the OpenGL context of the NanoVG context current,
+     *  outside of any NanoVG frame.
+     */
+    class layer_surface {
+    public:
+        explicit layer_surface(NVGcontext *vg);
+        layer_surface(const layer_surface&) = delete;
+        ~layer_surface();
+
+        /**
+         *  \brief Begin a NanoVG frame drawing into the surface. The previous content is lost
+         *  \return false if the surface storage could not be allocated : no frame is begun
+         */
+        bool begin(unsigned int width, unsigned int height);
+
+        /**
+         *  \brief End the frame, and restore the framebuffer that was bound before begin
+         */
+        void end();
+
+        /**
+         *  \brief Return false if the OpenGL context was destroyed since the surface creation
+         */
+        bool valid() const noexcept;
+
+        NVGcontext *context() const noexcept { return _vg; }
+        int image() const noexcept { return _image; }
+        unsigned int width() const noexcept { return _framebuffer.width(); }
+        unsigned int height() const noexcept { return _framebuffer.height(); }
+
+    private:
+        NVGcontext *_vg;
+        const std::uint64_t _context_id;
+        gl_framebuffer _framebuffer{};
+        int _image{0};
+
+        //  Drawing state saved by begin
+        int _previous_framebuffer{0};
+        int _previous_viewport[4]{};
+        float _previous_clear_color[4]{};
+    };
+
+    /**
+     *  \brief Render the layers drawn into layer_surfaces, after a frame was drawn with a context
+     */
+    using layer_renderer = void (*)(NVGcontext *vg);
+
+    /**
+     *  \brief Register a layer renderer, called by render_layers (registering twice has no effect)
+     *  \note Can be called from any thread
+     */
+    void register_layer_renderer(layer_renderer renderer);
+
+    /**
+     *  \brief Call every registered layer renderer
+     *  \note Called by the displays after each frame, with the OpenGL context current
+     */
+    void render_layers(NVGcontext *vg);
+
+}
+
+#endif
@@ -0,0 +1,53 @@
+
+#include "ui_task_queue.h"
+
+namespace View {
+
+    void ui_task_queue::post_damage(const area& a) noexcept
+    {
+        if (!_damage.try_push(a))
+            _damage_overflow.store(true, std::memory_order_release);
+    }
+
+    void ui_task_queue::post_task(task t)
+    {
+        _tasks.push(std::move(t));
+    }
+
+    void ui_task_queue::drain_damage(damage_region& region, const area& whole_area)
+    {
+        area a;
+
+        while (_damage.try_pop(a))
+            region.add(a);
+
+        if (_damage_overflow.exchange(false, std::memory_order_acquire))
+            region.add(whole_area);
+    }
+
+    std::size_t ui_task_queue::run_tasks()
+    {
+        auto count = 0u;
+        task t;
+
+        //  Closures posted while running are executed too
+        while (_tasks.try_pop(t)) {
+            t();
+            ++count;
+        }
+
+        return count;
+    }
+
+    bool ui_task_queue::run_task()
+    {
+        task t;
+
+        if (!_tasks.try_pop(t))
+            return false;
+
+        t();
+        return true;
+    }
+
+}
@@ -0,0 +1,212 @@
+#ifndef VIEW_UI_TASK_QUEUE_H_
+#define VIEW_UI_TASK_QUEUE_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "damage_region.h"
+
+namespace View {
+
+    /**
+     *  \class bounded_mpsc_queue
+     *  \brief Fixed capacity, lock-free, multiple producers single consumer queue
+     *  \details Push never allocate memory and never block : it is safe from a real time (audio) thread.
+     *  Based on the Dmitry Vyukov bounded queue : each cell hold a sequence number telling
+     *  whether it is ready to be written or read.
+     */
+    template <typename T, std::size_t Capacity>
+    class bounded_mpsc_queue {
+        static_assert(Capacity >= 2u && (Capacity & (Capacity - 1u)) == 0u, "Capacity must be a power of two");
+        static constexpr auto mask = Capacity - 1u;
+
+    public:
+        bounded_mpsc_queue() noexcept
+        {
+            for (auto i = 0u; i < Capacity; ++i)
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        bounded_mpsc_queue(const bounded_mpsc_queue&) = delete;
+
+        /**
+         *  \brief Push a value, from any thread
+         *  \return false if the queue is full
+         */
+        bool try_push(const T& value) noexcept
+        {
+            auto pos = _enqueue_pos.load(std::memory_order_relaxed);
+
+            for (;;) {
+                auto& c = _cells[pos & mask];
+                const auto sequence = c.sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+                if (diff == 0) {
+                    //  The cell is free : try to reserve it
+                    if (_enqueue_pos.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed)) {
+                        c.value = value;
+                        c.sequence.store(pos + 1u, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0) {
+                    //  The cell has not been read since the previous lap
+                    return false;
+                }
+                else {
+                    //  An other producer took the cell
+                    pos = _enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         *  \brief Pop a value, from the consumer thread only
+         *  \return false if the queue is empty
+         */
+        bool try_pop(T& value) noexcept
+        {
+            const auto pos = _dequeue_pos.load(std::memory_order_relaxed);
+            auto& c = _cells[pos & mask];
+            const auto sequence = c.sequence.load(std::memory_order_acquire);
+
+            if (sequence != pos + 1u)
+                return false;
+
+            _dequeue_pos.store(pos + 1u, std::memory_order_relaxed);
+            value = c.value;
+            c.sequence.store(pos + Capacity, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        struct cell {
+            std::atomic<std::size_t> sequence;
+            T value;
+        };
+
+        std::array<cell, Capacity> _cells{};
+        alignas(64) std::atomic<std::size_t> _enqueue_pos{0u};
+        alignas(64) std::atomic<std::size_t> _dequeue_pos{0u};
+    };
+
+    /**
+     *  \class mpsc_queue
+     *  \brief Unbounded, lock-free, multiple producers single consumer queue
+     *  \details Intrusive Dmitry Vyukov queue : producers only exchange the head pointer.
+     *  Each push allocate a node.
+     */
+    template <typename T>
+    class mpsc_queue {
+        struct node {
+            std::atomic<node*> next{nullptr};
+            T value{};
+        };
+
+    public:
+        mpsc_queue()
+        :   _head{new node{}}, _tail{_head.load()}
+        {}
+
+        mpsc_queue(const mpsc_queue&) = delete;
+
+        ~mpsc_queue()
+        {
+            while (_tail != nullptr) {
+                auto next = _tail->next.load(std::memory_order_relaxed);
+                delete _tail;
+                _tail = next;
+            }
+        }
+
+        /**
+         *  \brief Push a value, from any thread
+         */
+        void push(T value)
+        {
+            auto n = new node{};
+            n->value = std::move(value);
+            const auto previous = _head.exchange(n, std::memory_order_acq_rel);
+            previous->next.store(n, std::memory_order_release);
+        }
+
+        /**
+         *  \brief Pop a value, from the consumer thread only
+         *  \return false if the queue is empty (or a push is not yet complete)
+         */
+        bool try_pop(T& value)
+        {
+            //  _tail is a consumed node : the value is held by the next one
+            const auto next = _tail->next.load(std::memory_order_acquire);
+
+            if (next == nullptr)
+                return false;
+
+            value = std::move(next->value);
+            delete _tail;
+            _tail = next;
+            return true;
+        }
+
+    private:
+        std::atomic<node*> _head;
+        node *_tail;
+    };
+
+    /**
+     *  \class ui_task_queue
+     *  \brief Transmit damaged areas and closures from any thread to the event loop thread
+     *  \details Producers never take a lock. The queue does not wake up the event loop :
+     *  this is left to the backend, which knows how to interrupt its own loop.
+     */
+    class ui_task_queue {
+    public:
+        using area = damage_region::area;
+        using task = std::function<void()>;
+
+        static constexpr auto damage_capacity = 256u;
+
+        /**
+         *  \brief Post an area to be redrawn, from any thread (without allocation)
+         *  \details if too many areas are pending, the whole display is redrawn
+         */
+        void post_damage(const area& a) noexcept;
+
+        /**
+         *  \brief Post a closure to be executed on the event loop thread
+         *  \note Never block, but allocate a queue node : unlike post_damage, not for real time threads
+         */
+        void post_task(task t);
+
+        /**
+         *  \brief Move every pending damaged area into the region (event loop thread only)
+         *  \param whole_area area added in case of overflow
+         */
+        void drain_damage(damage_region& region, const area& whole_area);
+
+        /**
+         *  \brief Execute every pending closure (event loop thread only)
+         *  \return the number of executed closures
+         */
+        std::size_t run_tasks();
+
+        /**
+         *  \brief Execute the oldest pending closure (event loop thread only)
+         *  \details The queue is not accessed once the closure was called : the closure may destroy it.
+         *  \return false if no closure was pending
+         */
+        bool run_task();
+
+    private:
+        bounded_mpsc_queue<area, damage_capacity> _damage{};
+        std::atomic<bool> _damage_overflow{false};
+        mpsc_queue<task> _tasks{};
+    };
+
+}
+
+#endif
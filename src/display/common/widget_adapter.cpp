@@ -1,7 +1,11 @@
 
 
 #include "widget_adapter.h"
+#include "layer_surface.h"
+#include "drawing/glyph_warmup.h"
 #include "drawing/text_helper.h"
+#include "helpers/draw_profiler.h"
+#include "internal_fonts/internal_fonts.h"
 #include <iostream>
 
 namespace View {
@@ -22,6 +26,7 @@ namespace View {
         float widget_width, widget_height;
         _coord_display2widget(width, height, widget_width, widget_height);
 
+        draw_profiler::scope trace{"resize", _root};
         _root.resize(widget_width, widget_height);
     }
 
@@ -33,7 +38,10 @@ namespace View {
             _pixel_per_unit,
             _pixel_per_unit);
 
-        _root.draw(vg);
+        {
+            draw_profiler::scope trace{"draw", _root};
+            _root.draw(vg);
+        }
 
         nvgRestore(vg);
     }
@@ -55,12 +63,60 @@ namespace View {
                 static_cast<float>(left) / _pixel_per_unit,
                 static_cast<float>(right) / _pixel_per_unit);
 
-        _root.draw_rect(vg, redraw_rect);
+        {
+            draw_profiler::scope trace{"draw_rect", _root};
+            _root.draw_rect(vg, redraw_rect);
+        }
 
         nvgRestore(vg);
     }
 
+    void widget_adapter::sys_update_layers(NVGcontext *vg)
+    {
+        render_layers(vg);
+    }
+
+    void widget_adapter::sys_prerender_glyphs(NVGcontext *vg)
+    {
+        prerender_internal_fonts(vg, _pixel_per_unit);
+    }
+
+    bool widget_adapter::sys_warmup_glyphs(NVGcontext *vg)
+    {
+        return glyph_warmup::pending(vg, _pixel_per_unit) && glyph_warmup::process(vg, _pixel_per_unit);
+    }
+
+    bool widget_adapter::sys_glyphs_pending(NVGcontext *vg)
+    {
+        return glyph_warmup::pending(vg, _pixel_per_unit);
+    }
+
     bool widget_adapter::sys_mouse_move(unsigned int cx, unsigned int cy)
+    {
+        flush_mouse_move();
+        return _deliver_mouse_move(cx, cy);
+    }
+
+    void widget_adapter::queue_mouse_move(unsigned int cx, unsigned int cy)
+    {
+        if (_motion_compression && !_pending_moves.empty())
+            _pending_moves.back() = {cx, cy};
+        else
+            _pending_moves.push_back({cx, cy});
+    }
+
+    bool widget_adapter::flush_mouse_move()
+    {
+        bool ret = false;
+
+        for (const auto& position : _pending_moves)
+            ret = _deliver_mouse_move(position.x, position.y) || ret;
+
+        _pending_moves.clear();
+        return ret;
+    }
+
+    bool widget_adapter::_deliver_mouse_move(unsigned int cx, unsigned int cy)
     {
         bool ret = false;
         float old_cursor_x = _cursor_fx;
@@ -74,6 +130,7 @@ namespace View {
         }
 
         if (_is_draging) {
+            draw_profiler::scope trace{"on_mouse_drag", _root};
             return _root.on_mouse_drag(
                 _draging_button,
                 _cursor_fx, _cursor_fy,
@@ -81,17 +138,23 @@ namespace View {
                 _cursor_fy - old_cursor_y) || ret;
         }
         else {
+            draw_profiler::scope trace{"on_mouse_move", _root};
             return _root.on_mouse_move(_cursor_fx, _cursor_fy) || ret;
         }
     }
 
     bool widget_adapter::sys_mouse_enter(void)
     {
+        flush_mouse_move();
+
         return _root.on_mouse_enter();
     }
 
     bool widget_adapter::sys_mouse_exit(void)
     {
+        //  Moves queued before leaving the window are delivered
+        flush_mouse_move();
+
         _pressed_button_count = 0u;
         _is_draging = false;
         return _root.on_mouse_exit();
@@ -99,6 +162,8 @@ namespace View {
 
     bool widget_adapter::sys_mouse_button_down(const mouse_button button)
     {
+        flush_mouse_move();
+
         // Cancel lost drag
         if (_is_draging && _draging_button == button) {
             if (_pressed_button_count > 0)
@@ -109,16 +174,21 @@ namespace View {
         _pressed_button_count++;
         _draging_button = button;
         _root.on_mouse_move(_cursor_fx, _cursor_fy);
+        draw_profiler::scope trace{"on_mouse_button_down", _root};
         return _root.on_mouse_button_down(button, _cursor_fx, _cursor_fy);
     }
 
     bool widget_adapter::sys_mouse_button_up(const mouse_button button)
     {
+        flush_mouse_move();
+
         _root.on_mouse_move(_cursor_fx, _cursor_fy);
 
         if (_pressed_button_count > 0)
             _pressed_button_count--;
 
+        draw_profiler::scope trace{"on_mouse_button_up", _root};
+
         if (_is_draging && button == _draging_button) {
             _is_draging = false;
             return _root.on_mouse_drag_end(button, _cursor_fx, _cursor_fy) ||
@@ -131,17 +201,26 @@ namespace View {
 
     bool widget_adapter::sys_mouse_wheel(const float distance)
     {
+        flush_mouse_move();
+
+        draw_profiler::scope trace{"on_mouse_wheel", _root};
         return _root.on_mouse_wheel(_cursor_fx, _cursor_fy, distance);
     }
 
     bool widget_adapter::sys_mouse_dbl_click(void)
     {
+        flush_mouse_move();
+
         _root.on_mouse_move(_cursor_fx, _cursor_fy);
+        draw_profiler::scope trace{"on_mouse_dbl_click", _root};
         return _root.on_mouse_dbl_click(_cursor_fx, _cursor_fy);
     }
 
     bool widget_adapter::sys_char_input(char c)
     {
+        flush_mouse_move();
+
+        draw_profiler::scope trace{"on_char_input", _root};
         return _root.on_char_input(c);
     }
 
@@ -1,6 +1,8 @@
 #ifndef VIEW_WIDGET_ADAPTER_H_
 #define VIEW_WIDGET_ADAPTER_H_
 
+#include <vector>
+
 #include "widget/widget.h"
 #include "display/common/display_controler.h"
 
@@ -35,6 +37,11 @@ namespace View {
          */
         void resize_display(unsigned int width, unsigned int height);
 
+        /**
+         *  \brief Stop controlling the root widget, when the display is closed before being destroyed
+         */
+        void detach_root() noexcept { _detach(); }
+
         /**
          *  'Low level' callback, called by system event processing
          *  and translated into 'higher level' events.
@@ -46,6 +53,29 @@ namespace View {
             NVGcontext *vg, unsigned int top, unsigned int bottom,
             unsigned int left, unsigned int right);
 
+        /**
+         *  \brief Render the cached layers invalidated since the last frame
+         *  \note Must be called after nvgEndFrame, with the drawing framebuffer still bound
+         */
+        void sys_update_layers(NVGcontext *vg);
+
+        /**
+         *  \brief Rasterize the common glyphs at the display resolution, before the first frame
+         */
+        void sys_prerender_glyphs(NVGcontext *vg);
+
+        /**
+         *  \brief Rasterize a part of the glyphs posted to glyph_warmup
+         *  \note Must be called outside of a frame, after the frame was presented
+         *  \return true if glyphs are still waiting to be rasterized
+         */
+        bool sys_warmup_glyphs(NVGcontext *vg);
+
+        /**
+         *  \brief Return true if glyphs posted to glyph_warmup are waiting to be rasterized with this context
+         */
+        bool sys_glyphs_pending(NVGcontext *vg);
+
         bool sys_mouse_move(unsigned int cx, unsigned int cy);
         bool sys_mouse_enter(void);
         bool sys_mouse_exit(void);
@@ -54,6 +84,19 @@ namespace View {
         bool sys_mouse_wheel(const float distance);
         bool sys_mouse_dbl_click(void);
         bool sys_char_input(char);
+
+        /**
+         *  Motion compression : mouse moves are queued and delivered by flush_mouse_move,
+         *  that the display call once per frame. By default, only the last position is
+         *  delivered (drag deltas are accumulated since the previous delivered position).
+         *  With compression disabled, every queued position is delivered at flush, for
+         *  widgets that need the full motion resolution.
+         *  Any other sys event flush the pending moves first, so that event order is kept.
+         */
+        void queue_mouse_move(unsigned int cx, unsigned int cy);
+        bool flush_mouse_move();
+        bool has_pending_mouse_move() const noexcept { return !_pending_moves.empty(); }
+        void set_motion_compression(bool enabled) noexcept { _motion_compression = enabled; }
     protected:
         /**
          *  \brief Inform the underlying display that an area must be redrawn
@@ -68,6 +111,8 @@ namespace View {
         void invalidate_rect(const rectangle<>& rect) override;
         float widget_pos_x() override;
         float widget_pos_y() override;
+        bool _deliver_mouse_move(unsigned int cx, unsigned int cy);
+
         /**
          *  Display / Widget coordinate translation
          */
@@ -79,6 +124,14 @@ namespace View {
         unsigned int _display_height;
         float _pixel_per_unit;
 
+        struct display_position {
+            unsigned int x;
+            unsigned int y;
+        };
+
+        std::vector<display_position> _pending_moves{};
+        bool _motion_compression{true};
+
         float _cursor_fx{0.f};
         float _cursor_fy{0.f};
         bool _is_draging{false};
@@ -28,4 +28,34 @@ namespace View {
         return _backend->windows_is_open();
     }
 
+    void application_display::post_to_ui_thread(std::function<void()> task)
+    {
+        _backend->post_to_ui_thread(std::move(task));
+    }
+
+    void application_display::set_vsync(vsync_mode mode)
+    {
+        _backend->set_vsync(mode);
+    }
+
+    void application_display::set_max_fps(float fps)
+    {
+        _backend->set_max_fps(fps);
+    }
+
+    void application_display::set_motion_compression(bool enabled)
+    {
+        _backend->set_motion_compression(enabled);
+    }
+
+    frame_statistics application_display::get_frame_statistics() const
+    {
+        return _backend->get_frame_statistics();
+    }
+
+    input_latency_statistics application_display::get_input_latency_statistics() const
+    {
+        return _backend->get_input_latency_statistics();
+    }
+
 } /* View */
\ No newline at end of file
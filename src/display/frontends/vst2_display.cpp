@@ -33,6 +33,36 @@ namespace View
             _convert_char(index, value, opt));
     }
 
+    void vst2_display::post_to_ui_thread(std::function<void()> task)
+    {
+        _backend->post_to_ui_thread(std::move(task));
+    }
+
+    void vst2_display::set_vsync(vsync_mode mode)
+    {
+        _backend->set_vsync(mode);
+    }
+
+    void vst2_display::set_max_fps(float fps)
+    {
+        _backend->set_max_fps(fps);
+    }
+
+    void vst2_display::set_motion_compression(bool enabled)
+    {
+        _backend->set_motion_compression(enabled);
+    }
+
+    frame_statistics vst2_display::get_frame_statistics() const
+    {
+        return _backend->get_frame_statistics();
+    }
+
+    input_latency_statistics vst2_display::get_input_latency_statistics() const
+    {
+        return _backend->get_input_latency_statistics();
+    }
+
     char vst2_display::_convert_char(int32_t index, intptr_t value, int32_t opt)
     {
         constexpr auto backspace = 8;
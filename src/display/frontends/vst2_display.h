@@ -1,6 +1,7 @@
 #ifndef VIEW_VST2_DISPLAY_H_
 #define VIEW_VST2_DISPLAY_H_
 
+#include <functional>
 #include <memory>
 
 #include "display/backends/view_backend.h"
@@ -44,6 +45,41 @@ namespace View {
          */
         bool text_input(int32_t index, intptr_t value, int32_t opt);
 
+        /**
+         *  \brief Execute a closure on the display thread
+         *  \details Safe to call from any thread, without locking. The closure and a queue node
+         *  are allocated : do not call it from a real time (audio) thread, whose values should be
+         *  read by a closure or a widget instead. Widgets can be safely modified from the closure.
+         */
+        void post_to_ui_thread(std::function<void()> task);
+
+        /**
+         *  \brief Synchronize the frames with the display refresh (default : on)
+         */
+        void set_vsync(vsync_mode mode);
+
+        /**
+         *  \brief Limit the frame rate, for example while the window is in background
+         *  \param fps maximum frame per second, 0 for no limit
+         */
+        void set_max_fps(float fps);
+
+        /**
+         *  \brief Deliver only the last mouse position of each frame (default : enabled)
+         *  \details Disable it for widgets that need every mouse position, like drawing tools
+         */
+        void set_motion_compression(bool enabled);
+
+        /**
+         *  \brief Return frame timings, to monitor drawing performances
+         */
+        frame_statistics get_frame_statistics() const;
+
+        /**
+         *  \brief Return input to photon latency histograms, to monitor event handling performances
+         */
+        input_latency_statistics get_input_latency_statistics() const;
+
     private:
         static char _convert_char(int32_t index, intptr_t value, int32_t opt);
 
@@ -0,0 +1,216 @@
+
+#include <algorithm>
+
+#include "display_list.h"
+
+namespace View {
+
+    namespace {
+
+        //  Innermost recorder of the calling thread
+        thread_local display_list::recorder *current_recorder = nullptr;
+
+        thread_local NVGscissor probed_scissor{};
+
+        void probe_scissor(
+            void*, NVGpaint*, NVGcompositeOperationState, NVGscissor *scissor,
+            float, const float*, const NVGpath*, int)
+        {
+            probed_scissor = *scissor;
+        }
+
+        //  The scissor is not readable from the NanoVG interface : fill an empty path
+        //  and intercept the scissor given to the renderer.
+        NVGscissor current_scissor(NVGcontext *vg)
+        {
+            auto *params = nvgInternalParams(vg);
+            const auto render_fill = params->renderFill;
+
+            params->renderFill = probe_scissor;
+            nvgBeginPath(vg);
+            nvgFill(vg);
+            params->renderFill = render_fill;
+
+            return probed_scissor;
+        }
+
+        bool same_scissor(const NVGscissor& a, const NVGscissor& b) noexcept
+        {
+            return std::equal(a.xform, a.xform + 6, b.xform) && std::equal(a.extent, a.extent + 2, b.extent);
+        }
+
+    }
+
+    display_list::recorder::recorder(display_list& list, NVGcontext *vg)
+    :   _list{list},
+        _params{nvgInternalParams(vg)},
+        _forward{*_params},
+        _previous{current_recorder}
+    {
+        //  Probed before installing the recorder : the probe is not recorded
+        if (_list.empty())
+            _list._scissor = current_scissor(vg);
+
+        _params->renderFill = _record_fill;
+        _params->renderStroke = _record_stroke;
+        _params->renderTriangles = _record_triangles;
+        current_recorder = this;
+    }
+
+    display_list::recorder::~recorder()
+    {
+        _params->renderFill = _forward.renderFill;
+        _params->renderStroke = _forward.renderStroke;
+        _params->renderTriangles = _forward.renderTriangles;
+        current_recorder = _previous;
+    }
+
+    void display_list::clear() noexcept
+    {
+        _commands.clear();
+        _paths.clear();
+        _vertices.clear();
+        _images.clear();
+        _nested_scissor = false;
+    }
+
+    bool display_list::replay(NVGcontext *vg)
+    {
+        auto *params = nvgInternalParams(vg);
+
+        //  Font atlas and images may have been deleted since the recording
+        for (const auto image : _images) {
+            int width, height;
+            if (params->renderGetTextureSize(params->userPtr, image, &width, &height) == 0)
+                return false;
+        }
+
+        const auto current = current_scissor(vg);
+
+        //  The scissors set while recording were intersected with the recording one
+        if (_nested_scissor && !same_scissor(current, _scissor))
+            return false;
+
+        for (const auto& cmd : _commands) {
+            auto paint = cmd.paint;
+            auto scissor = _nested_scissor ? cmd.scissor : current;
+
+            switch (cmd.type) {
+            case command_type::fill:
+                params->renderFill(
+                    params->userPtr, &paint, cmd.composite_operation, &scissor,
+                    cmd.fringe, cmd.bounds, _build_paths(cmd), static_cast<int>(cmd.count));
+                break;
+
+            case command_type::stroke:
+                params->renderStroke(
+                    params->userPtr, &paint, cmd.composite_operation, &scissor,
+                    cmd.fringe, cmd.stroke_width, _build_paths(cmd), static_cast<int>(cmd.count));
+                break;
+
+            case command_type::triangles:
+                params->renderTriangles(
+                    params->userPtr, &paint, cmd.composite_operation, &scissor,
+                    _vertices.data() + cmd.first, static_cast<int>(cmd.count), cmd.fringe);
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    void display_list::_record_fill(
+        void *uptr, NVGpaint *paint, NVGcompositeOperationState composite_operation, NVGscissor *scissor,
+        float fringe, const float *bounds, const NVGpath *paths, int path_count)
+    {
+        auto *r = current_recorder;
+        auto& cmd = r->_list._add_command(command_type::fill, *paint, composite_operation, *scissor, fringe);
+        std::copy(bounds, bounds + 4, cmd.bounds);
+        r->_list._add_paths(cmd, paths, path_count);
+
+        //  Forward to the enclosing recorder, or to the renderer
+        current_recorder = r->_previous;
+        r->_forward.renderFill(uptr, paint, composite_operation, scissor, fringe, bounds, paths, path_count);
+        current_recorder = r;
+    }
+
+    void display_list::_record_stroke(
+        void *uptr, NVGpaint *paint, NVGcompositeOperationState composite_operation, NVGscissor *scissor,
+        float fringe, float stroke_width, const NVGpath *paths, int path_count)
+    {
+        auto *r = current_recorder;
+        auto& cmd = r->_list._add_command(command_type::stroke, *paint, composite_operation, *scissor, fringe);
+        cmd.stroke_width = stroke_width;
+        r->_list._add_paths(cmd, paths, path_count);
+
+        current_recorder = r->_previous;
+        r->_forward.renderStroke(uptr, paint, composite_operation, scissor, fringe, stroke_width, paths, path_count);
+        current_recorder = r;
+    }
+
+    void display_list::_record_triangles(
+        void *uptr, NVGpaint *paint, NVGcompositeOperationState composite_operation, NVGscissor *scissor,
+        const NVGvertex *vertices, int vertex_count, float fringe)
+    {
+        auto *r = current_recorder;
+        auto& list = r->_list;
+        auto& cmd = list._add_command(command_type::triangles, *paint, composite_operation, *scissor, fringe);
+        cmd.first = list._vertices.size();
+        cmd.count = static_cast<std::size_t>(vertex_count);
+        list._vertices.insert(list._vertices.end(), vertices, vertices + vertex_count);
+
+        current_recorder = r->_previous;
+        r->_forward.renderTriangles(uptr, paint, composite_operation, scissor, vertices, vertex_count, fringe);
+        current_recorder = r;
+    }
+
+    display_list::command& display_list::_add_command(
+        command_type type, const NVGpaint& paint, NVGcompositeOperationState composite_operation,
+        const NVGscissor& scissor, float fringe)
+    {
+        if (paint.image != 0 && std::find(_images.begin(), _images.end(), paint.image) == _images.end())
+            _images.push_back(paint.image);
+
+        if (!same_scissor(scissor, _scissor))
+            _nested_scissor = true;
+
+        _commands.push_back({type, paint, composite_operation, scissor, fringe, 0.f, {}, 0u, 0u});
+        return _commands.back();
+    }
+
+    void display_list::_add_paths(command& cmd, const NVGpath *paths, int path_count)
+    {
+        cmd.first = _paths.size();
+        cmd.count = static_cast<std::size_t>(path_count);
+
+        for (auto i = 0; i < path_count; ++i) {
+            const auto& path = paths[i];
+            recorded_path recorded{path, _vertices.size(), 0u};
+
+            _vertices.insert(_vertices.end(), path.fill, path.fill + path.nfill);
+            recorded.stroke_offset = _vertices.size();
+            _vertices.insert(_vertices.end(), path.stroke, path.stroke + path.nstroke);
+
+            recorded.path.fill = nullptr;
+            recorded.path.stroke = nullptr;
+            _paths.push_back(recorded);
+        }
+    }
+
+    const NVGpath *display_list::_build_paths(const command& cmd)
+    {
+        _replay_paths.resize(cmd.count);
+
+        for (auto i = 0u; i < cmd.count; ++i) {
+            const auto& recorded = _paths[cmd.first + i];
+            auto& path = _replay_paths[i];
+
+            path = recorded.path;
+            path.fill = _vertices.data() + recorded.fill_offset;
+            path.stroke = _vertices.data() + recorded.stroke_offset;
+        }
+
+        return _replay_paths.data();
+    }
+
+}
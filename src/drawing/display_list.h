@@ -0,0 +1,113 @@
+#ifndef VIEW_DISPLAY_LIST_H_
+#define VIEW_DISPLAY_LIST_H_
+
+#include <cstddef>
+#include <vector>
+
+#include <nanovg.h>
+
+namespace View {
+
+    /**
+     *  \class display_list
+     *  \brief Tessellated NanoVG rendering commands, that can be rendered again without building the paths
+     *  \details Commands are captured at the NanoVG renderer interface : replaying a list skip
+     *  the drawing code, the path building and the tessellation. Vertices are recorded in display
+     *  coordinates : a list can only be replayed with the transform it was recorded with.
+     *  When the recorded commands were only clipped by the scissor set before the recording, a
+     *  replayed list is clipped by the current scissor. When a scissor was set while recording,
+     *  the recorded scissors are used : the list can only be replayed with the scissor it was recorded with.
+     */
+    class display_list {
+    public:
+        /**
+         *  \class recorder
+         *  \brief Record the commands rendered with a context during the recorder lifetime
+         *  \details The commands are still rendered while recorded. Recorders can be nested :
+         *  the commands are recorded in every enclosing list.
+         */
+        class recorder {
+            friend class display_list;
+        public:
+            recorder(display_list& list, NVGcontext *vg);
+            recorder(const recorder&) = delete;
+            ~recorder();
+
+        private:
+            display_list& _list;
+            NVGparams *_params;
+            NVGparams _forward;
+            recorder *_previous;
+        };
+
+        void clear() noexcept;
+        bool empty() const noexcept { return _commands.empty(); }
+        std::size_t command_count() const noexcept { return _commands.size(); }
+        std::size_t vertex_count() const noexcept { return _vertices.size(); }
+
+        /**
+         *  \brief Return true if a scissor was set while recording
+         */
+        bool has_nested_scissor() const noexcept { return _nested_scissor; }
+
+        /**
+         *  \brief Render the recorded commands again
+         *  \return false, without rendering anything, if an image used by the commands was deleted,
+         *  or if a scissor was set while recording and the current scissor is not the recording one
+         */
+        bool replay(NVGcontext *vg);
+
+    private:
+        enum class command_type { fill, stroke, triangles };
+
+        struct command {
+            command_type type;
+            NVGpaint paint;
+            NVGcompositeOperationState composite_operation;
+            NVGscissor scissor;
+            float fringe;
+            float stroke_width;
+            float bounds[4];
+            std::size_t first;      /**< First path, or first vertex for triangles */
+            std::size_t count;      /**< Path count, or vertex count for triangles */
+        };
+
+        struct recorded_path {
+            NVGpath path;           /**< Vertex pointers are not valid */
+            std::size_t fill_offset;
+            std::size_t stroke_offset;
+        };
+
+        //  Renderer interface
+        static void _record_fill(
+            void *uptr, NVGpaint *paint, NVGcompositeOperationState composite_operation, NVGscissor *scissor,
+            float fringe, const float *bounds, const NVGpath *paths, int path_count);
+        static void _record_stroke(
+            void *uptr, NVGpaint *paint, NVGcompositeOperationState composite_operation, NVGscissor *scissor,
+            float fringe, float stroke_width, const NVGpath *paths, int path_count);
+        static void _record_triangles(
+            void *uptr, NVGpaint *paint, NVGcompositeOperationState composite_operation, NVGscissor *scissor,
+            const NVGvertex *vertices, int vertex_count, float fringe);
+
+        command& _add_command(
+            command_type type, const NVGpaint& paint, NVGcompositeOperationState composite_operation,
+            const NVGscissor& scissor, float fringe);
+        void _add_paths(command& cmd, const NVGpath *paths, int path_count);
+        const NVGpath *_build_paths(const command& cmd);
+
+        std::vector<command> _commands{};
+        std::vector<recorded_path> _paths{};
+        std::vector<NVGvertex> _vertices{};
+        std::vector<int> _images{};
+
+        //  Scissor set when the recording started
+        NVGscissor _scissor{};
+        bool _nested_scissor{false};
+
+        //  Replay buffer
+        std::vector<NVGpath> _replay_paths{};
+    };
+
+}
+
+#endif
@@ -0,0 +1,219 @@
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+#include "glyph_warmup.h"
+#include "display/common/gl_renderer.h"
+
+namespace View {
+
+    namespace {
+
+        //  Glyphs rasterized in one nvgText call
+        constexpr auto glyphs_per_batch = 16u;
+
+        struct glyph_batch {
+            int font_face;
+            float font_size;
+            std::string text;       //  UTF-8 encoded glyphs
+            unsigned int count;
+        };
+
+        //  Glyphs posted for a context font atlas, at a display scale
+        struct glyph_consumer {
+            NVGcontext *vg;
+            std::uint64_t context_id;
+            float pixel_ratio;
+            std::deque<glyph_batch> queue{};
+            std::unordered_set<std::uint64_t> posted{};
+        };
+
+        struct warmup_state {
+            std::mutex mutex{};
+            std::list<glyph_consumer> consumers{};
+            glyph_consumer backlog{nullptr, 0u, 0.f};   /**< Posted before any context processed them */
+        };
+
+        warmup_state& state()
+        {
+            static warmup_state instance{};
+            return instance;
+        }
+
+        std::uint64_t glyph_key(int font_face, float font_size, char32_t codepoint)
+        {
+            //  Font size quantized to 1/16 unit
+            const auto size = static_cast<std::uint64_t>(font_size * 16.f) & 0xffffu;
+            return (static_cast<std::uint64_t>(font_face & 0xff) << 56u) | (size << 32u) | codepoint;
+        }
+
+        //  Return false at the end of the text. Invalid sequences are skipped
+        bool next_codepoint(std::string_view text, std::size_t& pos, char32_t& codepoint, std::size_t& length)
+        {
+            while (pos < text.size()) {
+                const auto c = static_cast<unsigned char>(text[pos]);
+                length =
+                    c < 0x80u ? 1u :
+                    (c >> 5u) == 0x6u ? 2u :
+                    (c >> 4u) == 0xeu ? 3u :
+                    (c >> 3u) == 0x1eu ? 4u : 0u;
+
+                if (length == 0u || pos + length > text.size()) {
+                    pos++;
+                    continue;
+                }
+
+                codepoint = length == 1u ? c : (c & (0x7fu >> length));
+                for (auto i = 1u; i < length; ++i)
+                    codepoint = (codepoint << 6u) | (static_cast<unsigned char>(text[pos + i]) & 0x3fu);
+
+                pos += length;
+                return true;
+            }
+
+            return false;
+        }
+
+        void queue_glyphs(glyph_consumer& consumer, std::string_view text, int font_face, float font_size)
+        {
+            glyph_batch batch{font_face, font_size, {}, 0u};
+            std::size_t pos = 0u;
+            std::size_t length;
+            char32_t codepoint;
+
+            while (next_codepoint(text, pos, codepoint, length)) {
+                //  Whitespaces and control characters have no bitmap
+                if (codepoint <= 0x20u || !consumer.posted.insert(glyph_key(font_face, font_size, codepoint)).second)
+                    continue;
+
+                batch.text.append(text.substr(pos - length, length));
+
+                if (++batch.count == glyphs_per_batch) {
+                    consumer.queue.push_back(std::move(batch));
+                    batch = glyph_batch{font_face, font_size, {}, 0u};
+                }
+            }
+
+            if (batch.count > 0u)
+                consumer.queue.push_back(std::move(batch));
+        }
+
+        glyph_consumer *find_consumer(warmup_state& s, std::uint64_t context_id, float pixel_ratio)
+        {
+            for (auto& consumer : s.consumers)
+                if (consumer.context_id == context_id && consumer.pixel_ratio == pixel_ratio)
+                    return &consumer;
+
+            return nullptr;
+        }
+
+        glyph_consumer& acquire_consumer(warmup_state& s, NVGcontext *vg, std::uint64_t context_id, float pixel_ratio)
+        {
+            if (auto *consumer = find_consumer(s, context_id, pixel_ratio))
+                return *consumer;
+
+            //  Forget the deleted contexts
+            s.consumers.remove_if(
+                [](const glyph_consumer& consumer)
+                {
+                    return nanovg_gl_context_id(consumer.vg) != consumer.context_id;
+                });
+
+            auto& consumer = s.consumers.emplace_back(glyph_consumer{vg, context_id, pixel_ratio});
+
+            if (s.consumers.size() == 1u) {
+                consumer.queue = std::move(s.backlog.queue);
+                consumer.posted = std::move(s.backlog.posted);
+                s.backlog.queue.clear();
+                s.backlog.posted.clear();
+            }
+
+            return consumer;
+        }
+
+    }
+
+    void glyph_warmup::post(std::string_view text, int font_face, float font_size)
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock{s.mutex};
+
+        if (s.consumers.empty()) {
+            queue_glyphs(s.backlog, text, font_face, font_size);
+        }
+        else {
+            for (auto& consumer : s.consumers)
+                queue_glyphs(consumer, text, font_face, font_size);
+        }
+    }
+
+    bool glyph_warmup::pending(NVGcontext *vg, float pixel_ratio)
+    {
+        const auto context_id = nanovg_gl_context_id(vg);
+        auto& s = state();
+        std::lock_guard<std::mutex> lock{s.mutex};
+
+        if (s.consumers.empty())
+            return !s.backlog.queue.empty();
+
+        const auto *consumer = find_consumer(s, context_id, pixel_ratio);
+        return consumer != nullptr && !consumer->queue.empty();
+    }
+
+    bool glyph_warmup::process(NVGcontext *vg, float pixel_ratio, clock::duration budget)
+    {
+        const auto context_id = nanovg_gl_context_id(vg);
+        auto& s = state();
+        const auto deadline = clock::now() + budget;
+        bool frame_started = false;
+        bool remaining = false;
+
+        //  The consumers are not destroyed while their context exist
+        glyph_consumer *consumer;
+        {
+            std::lock_guard<std::mutex> lock{s.mutex};
+            consumer = &acquire_consumer(s, vg, context_id, pixel_ratio);
+        }
+
+        for (;;) {
+            glyph_batch batch;
+
+            {
+                std::lock_guard<std::mutex> lock{s.mutex};
+
+                if (consumer->queue.empty())
+                    break;
+
+                if (clock::now() >= deadline) {
+                    remaining = true;
+                    break;
+                }
+
+                batch = std::move(consumer->queue.front());
+                consumer->queue.pop_front();
+            }
+
+            //  Glyphs are rasterized and uploaded by nvgText : the drawing itself is discarded
+            if (!frame_started) {
+                nvgBeginFrame(vg, 1.f, 1.f, 1.f);
+                nvgScale(vg, pixel_ratio, pixel_ratio);
+                frame_started = true;
+            }
+
+            nvgFontFaceId(vg, batch.font_face);
+            nvgFontSize(vg, batch.font_size);
+            nvgText(vg, 0.f, 0.f, batch.text.data(), batch.text.data() + batch.text.size());
+        }
+
+        if (frame_started)
+            nvgCancelFrame(vg);
+
+        return remaining;
+    }
+
+}
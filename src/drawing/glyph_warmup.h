@@ -0,0 +1,52 @@
+#ifndef VIEW_GLYPH_WARMUP_H_
+#define VIEW_GLYPH_WARMUP_H_
+
+#include <chrono>
+#include <string_view>
+
+#include <nanovg.h>
+
+namespace View {
+
+    /**
+     *  \class glyph_warmup
+     *  \brief Rasterize glyphs ahead of their first use, a little after each frame
+     *  \details Text that will soon be displayed (for example every caption of a list, while
+     *  only a few rows are visible) can be posted from any thread. The drawing thread then
+     *  rasterize the new glyphs after each frame, within a time budget, instead of all at once
+     *  inside nvgText when the text first appear. Glyphs that were not warmed up yet when
+     *  drawn are still rasterized on demand.
+     *  Glyphs are rasterized in the font atlas of a NanoVG context, at the display scale : they are
+     *  queued for each context and scale that process them. Glyphs posted before any display processed
+     *  them are given to the first one.
+     */
+    class glyph_warmup {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        static constexpr auto default_frame_budget = std::chrono::microseconds{1000};
+
+        /**
+         *  \brief Queue the glyphs of an UTF-8 text (any thread)
+         *  \details Glyphs already posted for this font face and size are ignored, for each context and scale.
+         */
+        static void post(std::string_view text, int font_face, float font_size);
+
+        /**
+         *  \brief Return true if posted glyphs are waiting to be rasterized with a context at a scale
+         *  \param pixel_ratio display pixels per widget unit
+         */
+        static bool pending(NVGcontext *vg, float pixel_ratio);
+
+        /**
+         *  \brief Rasterize queued glyphs until the budget is spent
+         *  \note Called by the displays after each frame, with the OpenGL context current
+         *  \param pixel_ratio display pixels per widget unit
+         *  \return true if glyphs are still queued
+         */
+        static bool process(NVGcontext *vg, float pixel_ratio, clock::duration budget = default_frame_budget);
+    };
+
+}
+
+#endif
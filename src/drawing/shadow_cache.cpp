@@ -0,0 +1,338 @@
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "shadow_cache.h"
+#include "display/common/gl_renderer.h"
+
+namespace View {
+
+    namespace {
+
+        float current_pixel_scale(NVGcontext *vg)
+        {
+            float transform[6];
+            nvgCurrentTransform(vg, transform);
+            return std::sqrt(transform[0] * transform[0] + transform[1] * transform[1]);
+        }
+
+        std::uint32_t pack_color(const NVGcolor& color)
+        {
+            const auto channel =
+                [](float value)
+                {
+                    return static_cast<std::uint32_t>(std::lround(std::clamp(value, 0.f, 1.f) * 255.f));
+                };
+
+            return (channel(color.r) << 24u) | (channel(color.g) << 16u) | (channel(color.b) << 8u) | channel(color.a);
+        }
+
+        //  Same distance function as the NanoVG shaders
+        float sdroundrect(float px, float py, float extent_x, float extent_y, float radius)
+        {
+            const auto dx = std::abs(px) - (extent_x - radius);
+            const auto dy = std::abs(py) - (extent_y - radius);
+            return std::min(std::max(dx, dy), 0.f) + std::hypot(std::max(dx, 0.f), std::max(dy, 0.f)) - radius;
+        }
+
+        //  Premultiplied gradient color, as blended by the NanoVG shaders
+        void write_pixel(
+            std::uint8_t *pixel, const NVGcolor& inner, const NVGcolor& outer, float d, float coverage)
+        {
+            const auto channel =
+                [d, coverage](float inner_value, float inner_alpha, float outer_value, float outer_alpha)
+                {
+                    const auto value = (inner_value * inner_alpha * (1.f - d) + outer_value * outer_alpha * d) * coverage;
+                    return static_cast<std::uint8_t>(std::lround(std::clamp(value, 0.f, 1.f) * 255.f));
+                };
+
+            pixel[0] = channel(inner.r, inner.a, outer.r, outer.a);
+            pixel[1] = channel(inner.g, inner.a, outer.g, outer.a);
+            pixel[2] = channel(inner.b, inner.a, outer.b, outer.a);
+            pixel[3] = channel(1.f, inner.a, 1.f, outer.a);
+        }
+
+    }
+
+    bool shadow_cache::image_key::operator==(const image_key& other) const noexcept
+    {
+        return
+            std::memcmp(params, other.params, sizeof(params)) == 0 &&
+            inner == other.inner && outer == other.outer && scale == other.scale;
+    }
+
+    std::size_t shadow_cache::image_key_hash::operator()(const image_key& key) const noexcept
+    {
+        std::size_t hash = std::hash<std::uint64_t>{}((static_cast<std::uint64_t>(key.inner) << 32u) | key.outer);
+
+        for (auto value : key.params)
+            hash = hash * 31u + std::hash<float>{}(value);
+
+        return hash * 31u + std::hash<float>{}(key.scale);
+    }
+
+    bool shadow_cache::fill(NVGcontext *vg, float x, float y, float width, float height, const box_shadow& shadow)
+    {
+        if (!_enabled)
+            return false;
+
+        const auto scale = current_pixel_scale(vg);
+        const auto *slice = _get_box(vg, shadow, scale);
+
+        //  Shapes smaller than the corners are drawn with the gradient
+        if (slice == nullptr || width < slice->left + slice->right || height < slice->top + slice->bottom)
+            return false;
+
+        _draw(vg, x, y, width, height, *slice);
+        return true;
+    }
+
+    bool shadow_cache::fill(NVGcontext *vg, float cx, float cy, const circle_shadow& shadow)
+    {
+        if (!_enabled)
+            return false;
+
+        const auto scale = current_pixel_scale(vg);
+        const auto *slice = _get_circle(vg, shadow, scale);
+
+        if (slice == nullptr)
+            return false;
+
+        _draw(vg, cx - slice->width / 2.f, cy - slice->height / 2.f, slice->width, slice->height, *slice);
+        return true;
+    }
+
+    std::size_t shadow_cache::size() const noexcept
+    {
+        std::size_t count = 0u;
+
+        for (const auto& entry : _contexts)
+            count += entry.second.images.size();
+
+        return count;
+    }
+
+    const shadow_cache::nine_slice *shadow_cache::_get_box(NVGcontext *vg, const box_shadow& shadow, float scale)
+    {
+        //  Images are only rasterized at a few scales
+        scale = std::round(scale * 64.f) / 64.f;
+        auto *context = _get_context(vg);
+
+        if (context == nullptr || scale <= 0.f)
+            return nullptr;
+
+        const image_key key{
+            {
+                0.f,
+                shadow.inset_left, shadow.inset_top, shadow.inset_right, shadow.inset_bottom,
+                shadow.radius, shadow.feather, shadow.shape_radius
+            },
+            pack_color(shadow.inner), pack_color(shadow.outer), scale};
+
+        const auto it = context->images.find(key);
+
+        if (it != context->images.end())
+            return &it->second;
+        else if (context->images.size() >= max_images_per_context)
+            return nullptr;
+
+        //  The gradient vary along an edge only closer than this to the corner (NanoVG clamp the feather to 1)
+        const auto feather = std::max(1.f, shadow.feather);
+        const auto gradient_corner = std::max(shadow.radius, feather / 2.f);
+        const auto corner =
+            [&](float inset)
+            {
+                return std::max({inset + gradient_corner, shadow.shape_radius, 0.f}) + 1.f;
+            };
+
+        //  Beyond the corners, the center is at least 1 unit inside the gradient box (d = 0) and
+        //  inside the filled area (full coverage from half a pixel per unit) : inner color
+        nine_slice slice{
+            0, 0.f, 0.f,
+            corner(shadow.inset_left), corner(shadow.inset_top),
+            corner(shadow.inset_right), corner(shadow.inset_bottom),
+            shadow.inner, shadow.shape_radius <= 0.f || scale >= 0.5f};
+
+        //  Smallest size with a constant middle, rounded to whole pixels
+        const auto pixel_width = static_cast<int>(std::ceil((slice.left + slice.right + 2.f) * scale));
+        const auto pixel_height = static_cast<int>(std::ceil((slice.top + slice.bottom + 2.f) * scale));
+        slice.width = static_cast<float>(pixel_width) / scale;
+        slice.height = static_cast<float>(pixel_height) / scale;
+
+        const auto extent_x = (slice.width - shadow.inset_left - shadow.inset_right) / 2.f;
+        const auto extent_y = (slice.height - shadow.inset_top - shadow.inset_bottom) / 2.f;
+        const auto center_x = shadow.inset_left + extent_x;
+        const auto center_y = shadow.inset_top + extent_y;
+
+        std::vector<std::uint8_t> pixels(4u * pixel_width * pixel_height);
+
+        for (auto py = 0; py < pixel_height; ++py) {
+            for (auto px = 0; px < pixel_width; ++px) {
+                const auto ux = (static_cast<float>(px) + 0.5f) / scale;
+                const auto uy = (static_cast<float>(py) + 0.5f) / scale;
+
+                const auto distance = sdroundrect(ux - center_x, uy - center_y, extent_x, extent_y, shadow.radius);
+                const auto d = std::clamp((distance + feather / 2.f) / feather, 0.f, 1.f);
+
+                //  Antialiased border of the filled area
+                const auto coverage =
+                    shadow.shape_radius > 0.f ?
+                        std::clamp(
+                            0.5f - scale * sdroundrect(
+                                ux - slice.width / 2.f, uy - slice.height / 2.f,
+                                slice.width / 2.f, slice.height / 2.f, shadow.shape_radius),
+                            0.f, 1.f) :
+                        1.f;
+
+                write_pixel(&pixels[4u * (py * pixel_width + px)], shadow.inner, shadow.outer, d, coverage);
+            }
+        }
+
+        slice.image = nvgCreateImageRGBA(vg, pixel_width, pixel_height, NVG_IMAGE_PREMULTIPLIED, pixels.data());
+
+        if (slice.image == 0)
+            return nullptr;
+
+        return &context->images.emplace(key, slice).first->second;
+    }
+
+    const shadow_cache::nine_slice *shadow_cache::_get_circle(NVGcontext *vg, const circle_shadow& shadow, float scale)
+    {
+        scale = std::round(scale * 64.f) / 64.f;
+        auto *context = _get_context(vg);
+
+        if (context == nullptr || scale <= 0.f || shadow.radius <= 0.f)
+            return nullptr;
+
+        const image_key key{
+            {
+                1.f,
+                shadow.offset_x, shadow.offset_y, shadow.inner_radius, shadow.outer_radius, shadow.radius,
+                0.f, 0.f
+            },
+            pack_color(shadow.inner), pack_color(shadow.outer), scale};
+
+        const auto it = context->images.find(key);
+
+        if (it != context->images.end())
+            return &it->second;
+        else if (context->images.size() >= max_images_per_context)
+            return nullptr;
+
+        //  A single slice : the whole image is scaled with the circle
+        const auto pixel_size = static_cast<int>(std::ceil(2.f * shadow.radius * scale)) + 2;
+        const auto size = static_cast<float>(pixel_size) / scale;
+        const nine_slice slice{0, size, size, 0.f, 0.f, 0.f, 0.f};
+
+        const auto gradient_radius = (shadow.inner_radius + shadow.outer_radius) / 2.f;
+        const auto feather = std::max(1.f, shadow.outer_radius - shadow.inner_radius);
+
+        std::vector<std::uint8_t> pixels(4u * pixel_size * pixel_size);
+
+        for (auto py = 0; py < pixel_size; ++py) {
+            for (auto px = 0; px < pixel_size; ++px) {
+                const auto ux = (static_cast<float>(px) + 0.5f) / scale - size / 2.f;
+                const auto uy = (static_cast<float>(py) + 0.5f) / scale - size / 2.f;
+
+                const auto distance = std::hypot(ux - shadow.offset_x, uy - shadow.offset_y) - gradient_radius;
+                const auto d = std::clamp((distance + feather / 2.f) / feather, 0.f, 1.f);
+                const auto coverage = std::clamp(0.5f - scale * (std::hypot(ux, uy) - shadow.radius), 0.f, 1.f);
+
+                write_pixel(&pixels[4u * (py * pixel_size + px)], shadow.inner, shadow.outer, d, coverage);
+            }
+        }
+
+        const auto image = nvgCreateImageRGBA(vg, pixel_size, pixel_size, NVG_IMAGE_PREMULTIPLIED, pixels.data());
+
+        if (image == 0)
+            return nullptr;
+
+        auto& entry = context->images.emplace(key, slice).first->second;
+        entry.image = image;
+        return &entry;
+    }
+
+    shadow_cache::context_images *shadow_cache::_get_context(NVGcontext *vg)
+    {
+        //  Images can only be created in contexts known by the OpenGL renderer
+        const auto context_id = nanovg_gl_context_id(vg);
+
+        if (context_id == 0u)
+            return nullptr;
+
+        const auto it = _contexts.find(context_id);
+
+        if (it != _contexts.end())
+            return &it->second;
+
+        //  Forget the images of the deleted contexts
+        for (auto entry = _contexts.begin(); entry != _contexts.end();) {
+            if (nanovg_gl_context_id(entry->second.vg) != entry->first)
+                entry = _contexts.erase(entry);
+            else
+                ++entry;
+        }
+
+        return &_contexts.emplace(context_id, context_images{vg}).first->second;
+    }
+
+    void shadow_cache::_draw(NVGcontext *vg, float x, float y, float width, float height, const nine_slice& slice)
+    {
+        const float target_x[4] = {x, x + slice.left, x + width - slice.right, x + width};
+        const float target_y[4] = {y, y + slice.top, y + height - slice.bottom, y + height};
+        const float source_x[4] = {0.f, slice.left, slice.width - slice.right, slice.width};
+        const float source_y[4] = {0.f, slice.top, slice.height - slice.bottom, slice.height};
+
+        //  Slices thinner than this cover no pixel center : they would only cost a draw call
+        constexpr auto min_slice_size = 1.f / 256.f;
+
+        //  Antialiasing would blend the fringes of adjacent slices
+        nvgSave(vg);
+        nvgShapeAntiAlias(vg, 0);
+
+        for (auto row = 0u; row < 3u; ++row) {
+            const auto slice_height = target_y[row + 1u] - target_y[row];
+            const auto source_height = source_y[row + 1u] - source_y[row];
+
+            if (slice_height < min_slice_size || source_height <= 0.f)
+                continue;
+
+            for (auto column = 0u; column < 3u; ++column) {
+                const auto slice_width = target_x[column + 1u] - target_x[column];
+                const auto source_width = source_x[column + 1u] - source_x[column];
+
+                if (slice_width < min_slice_size || source_width <= 0.f)
+                    continue;
+
+                const auto kx = slice_width / source_width;
+                const auto ky = slice_height / source_height;
+
+                nvgBeginPath(vg);
+                nvgRect(vg, target_x[column], target_y[row], slice_width, slice_height);
+
+                if (slice.flat_center && row == 1u && column == 1u) {
+                    nvgFillColor(vg, slice.center);
+                }
+                else {
+                    nvgFillPaint(vg,
+                        nvgImagePattern(vg,
+                            target_x[column] - kx * source_x[column], target_y[row] - ky * source_y[row],
+                            kx * slice.width, ky * slice.height, 0.f, slice.image, 1.f));
+                }
+
+                nvgFill(vg);
+            }
+        }
+
+        nvgRestore(vg);
+    }
+
+    shadow_cache& thread_shadow_cache()
+    {
+        thread_local shadow_cache cache{};
+        return cache;
+    }
+
+}
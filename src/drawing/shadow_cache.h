@@ -0,0 +1,128 @@
+#ifndef VIEW_SHADOW_CACHE_H_
+#define VIEW_SHADOW_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include <nanovg.h>
+
+namespace View {
+
+    /**
+     *  \brief A rectangle or a rounded rectangle filled with a box gradient (see nvgBoxGradient)
+     *  \details The gradient box is given by its insets from the filled area, so that the same
+     *  shadow can be drawn at any size.
+     */
+    struct box_shadow {
+        float inset_left;
+        float inset_top;
+        float inset_right;
+        float inset_bottom;
+        float radius;           /**< Gradient box corner radius */
+        float feather;
+        NVGcolor inner;
+        NVGcolor outer;
+        float shape_radius;     /**< Filled area corner radius, 0 for a rectangle */
+    };
+
+    /**
+     *  \brief A circle filled with a radial gradient (see nvgRadialGradient)
+     */
+    struct circle_shadow {
+        float offset_x;         /**< Gradient center, relative to the circle center */
+        float offset_y;
+        float inner_radius;
+        float outer_radius;
+        NVGcolor inner;
+        NVGcolor outer;
+        float radius;           /**< Filled circle radius */
+    };
+
+    /**
+     *  \class shadow_cache
+     *  \brief Draw gradient filled shapes from images rasterized once
+     *  \details Box shadows are rasterized at their smallest size, as nine-slice images : the
+     *  corners are drawn as is and the edges are stretched, as the gradient is constant along the
+     *  straight edges. The center has the inner color : it is filled with a flat color.
+     *  Circle shadows are rasterized once per radius.
+     *  Images are rasterized at the display resolution, and are kept until their context is
+     *  deleted. A cache must only be used by one thread.
+     */
+    class shadow_cache {
+    public:
+        static constexpr std::size_t max_images_per_context = 64u;
+
+        /**
+         *  \brief Fill a rectangle with a box shadow
+         *  \return false if the shadow could not be drawn from an image : the caller must draw it
+         */
+        bool fill(NVGcontext *vg, float x, float y, float width, float height, const box_shadow& shadow);
+
+        /**
+         *  \brief Fill a circle with a circle shadow
+         *  \return false if the shadow could not be drawn from an image : the caller must draw it
+         */
+        bool fill(NVGcontext *vg, float cx, float cy, const circle_shadow& shadow);
+
+        /**
+         *  \brief When disabled, fill always return false and the callers draw the gradients (to compare both)
+         */
+        void set_enabled(bool enabled) noexcept { _enabled = enabled; }
+        bool enabled() const noexcept { return _enabled; }
+
+        /**
+         *  \brief Forget the images. They are deleted with their context
+         */
+        void clear() noexcept { _contexts.clear(); }
+
+        std::size_t size() const noexcept;
+
+    private:
+        struct image_key {
+            float params[8];
+            std::uint32_t inner;
+            std::uint32_t outer;
+            float scale;
+
+            bool operator==(const image_key& other) const noexcept;
+        };
+
+        struct image_key_hash {
+            std::size_t operator()(const image_key& key) const noexcept;
+        };
+
+        struct nine_slice {
+            int image;
+            float width;        /**< Image size, in widget units */
+            float height;
+            float left;         /**< Corner sizes */
+            float top;
+            float right;
+            float bottom;
+            NVGcolor center{};          /**< Color of the center slice */
+            bool flat_center{false};    /**< Fill the center slice with its color rather than the image */
+        };
+
+        struct context_images {
+            NVGcontext *vg;
+            std::unordered_map<image_key, nine_slice, image_key_hash> images{};
+        };
+
+        const nine_slice *_get_box(NVGcontext *vg, const box_shadow& shadow, float scale);
+        const nine_slice *_get_circle(NVGcontext *vg, const circle_shadow& shadow, float scale);
+        context_images *_get_context(NVGcontext *vg);
+        static void _draw(NVGcontext *vg, float x, float y, float width, float height, const nine_slice& slice);
+
+        std::unordered_map<std::uint64_t, context_images> _contexts{};
+        bool _enabled{true};
+    };
+
+    /**
+     *  \brief Return the shadow cache used by the drawing helpers of the calling thread
+     */
+    shadow_cache& thread_shadow_cache();
+
+}
+
+#endif
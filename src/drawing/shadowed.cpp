@@ -1,17 +1,29 @@
 
 #include "shadowed.h"
+#include "shadow_cache.h"
 
 namespace View {
-    
+
+    /*
+     *  The gradients are drawn from images cached by shadow_cache, as they are expensive to fill
+     *  in the fragment shaders. The gradients are only computed here when the shape is too small.
+     */
+
     void shadowed_down_rounded_rect(
         NVGcontext *vg,
         float x, float y, float width, float height, float radius, NVGcolor surface)
     {
         const auto shadow = nvgRGB(0, 0, 0);
-        const auto gradient = 
-            nvgBoxGradient(vg, x + 1.5f, y + 1.8f, width - 2.f, height- 2.f, radius, 2.f, surface, shadow);
-    
+
         //  Draw background (with shadow)
+        const box_shadow cached{1.5f, 1.8f, 0.5f, 0.2f, radius, 2.f, surface, shadow, radius};
+
+        if (thread_shadow_cache().fill(vg, x, y, width, height, cached))
+            return;
+
+        const auto gradient =
+            nvgBoxGradient(vg, x + 1.5f, y + 1.8f, width - 2.f, height- 2.f, radius, 2.f, surface, shadow);
+
         nvgBeginPath(vg);
         nvgRoundedRect(vg, x, y, width, height, radius);
         nvgFillPaint(vg, gradient);
@@ -25,14 +37,19 @@ namespace View {
     {
         const auto background = nvgRGBA(0, 0, 0, 0);
         const auto shadow = nvgRGB(0, 0, 0);
-        const auto gradient = 
-            nvgBoxGradient(vg, x + 1.5f, y + 1.8f, width - 1.f, height - 1.f, radius, 2.f, shadow, background);
 
         //  Draw shadow
-        nvgBeginPath(vg);
-        nvgRect(vg, x + 1.f, y + 1.f, width + 4.f, height + 4.f);
-        nvgFillPaint(vg, gradient);
-        nvgFill(vg);
+        const box_shadow cached{0.5f, 0.8f, 4.5f, 4.2f, radius, 2.f, shadow, background, 0.f};
+
+        if (!thread_shadow_cache().fill(vg, x + 1.f, y + 1.f, width + 4.f, height + 4.f, cached)) {
+            const auto gradient =
+                nvgBoxGradient(vg, x + 1.5f, y + 1.8f, width - 1.f, height - 1.f, radius, 2.f, shadow, background);
+
+            nvgBeginPath(vg);
+            nvgRect(vg, x + 1.f, y + 1.f, width + 4.f, height + 4.f);
+            nvgFillPaint(vg, gradient);
+            nvgFill(vg);
+        }
 
         //  Draw background
         nvgBeginPath(vg);
@@ -45,10 +62,16 @@ namespace View {
         NVGcontext *vg, float cx, float cy, float radius, NVGcolor surface)
     {
         const auto shadow = nvgRGB(0, 0, 0);
-        const auto gradient = 
-            nvgRadialGradient(vg, cx + 0.8f, cy + 1.f, radius - 1.1f, radius - 1.2f, surface, shadow);
 
         //  Draw background (with shadow)
+        const circle_shadow cached{0.8f, 1.f, radius - 1.1f, radius - 1.2f, surface, shadow, radius};
+
+        if (thread_shadow_cache().fill(vg, cx, cy, cached))
+            return;
+
+        const auto gradient =
+            nvgRadialGradient(vg, cx + 0.8f, cy + 1.f, radius - 1.1f, radius - 1.2f, surface, shadow);
+
         nvgBeginPath(vg);
         nvgCircle(vg, cx, cy, radius);
         nvgFillPaint(vg, gradient);
@@ -61,14 +84,19 @@ namespace View {
     {
         const auto background = nvgRGBA(0, 0, 0, 0);
         const auto shadow = nvgRGB(0, 0, 0);
-        const auto gradient = 
-            nvgRadialGradient(vg, cx + 1.f, cy + 1.2f, radius - 3.f, radius, shadow, background);
 
         //  Draw shadow
-        nvgBeginPath(vg);
-        nvgCircle(vg, cx, cy, radius + 4.f);
-        nvgFillPaint(vg, gradient);
-        nvgFill(vg);
+        const circle_shadow cached{1.f, 1.2f, radius - 3.f, radius, shadow, background, radius + 4.f};
+
+        if (!thread_shadow_cache().fill(vg, cx, cy, cached)) {
+            const auto gradient =
+                nvgRadialGradient(vg, cx + 1.f, cy + 1.2f, radius - 3.f, radius, shadow, background);
+
+            nvgBeginPath(vg);
+            nvgCircle(vg, cx, cy, radius + 4.f);
+            nvgFillPaint(vg, gradient);
+            nvgFill(vg);
+        }
 
         //  Draw background
         nvgBeginPath(vg);
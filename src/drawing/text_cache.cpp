@@ -0,0 +1,95 @@
+
+#include <cmath>
+#include <functional>
+
+#include "text_cache.h"
+#include "display/common/gl_renderer.h"
+
+namespace View {
+
+    static void combine_hash(std::size_t& seed, std::size_t value) noexcept
+    {
+        seed ^= value + 0x9e3779b9u + (seed << 6) + (seed >> 2);
+    }
+
+    //  Same quantization as the font scale computed by NanoVG
+    static float text_scale(NVGcontext *vg)
+    {
+        float t[6];
+        nvgCurrentTransform(vg, t);
+        const auto sx = std::sqrt(t[0] * t[0] + t[2] * t[2]);
+        const auto sy = std::sqrt(t[1] * t[1] + t[3] * t[3]);
+        return std::round((sx + sy) * 0.5f / 0.01f) * 0.01f;
+    }
+
+    bool text_cache::entry_key::operator==(const entry_key& other) const noexcept
+    {
+        return
+            vg == other.vg && context_id == other.context_id && font_face == other.font_face &&
+            font_size == other.font_size && scale == other.scale && text == other.text;
+    }
+
+    std::size_t text_cache::entry_key_hash::operator()(const entry_key& key) const noexcept
+    {
+        auto hash = std::hash<std::string_view>{}(key.text);
+        combine_hash(hash, std::hash<const void*>{}(key.vg));
+        combine_hash(hash, std::hash<std::uint64_t>{}(key.context_id));
+        combine_hash(hash, std::hash<int>{}(key.font_face));
+        combine_hash(hash, std::hash<float>{}(key.font_size));
+        combine_hash(hash, std::hash<float>{}(key.scale));
+        return hash;
+    }
+
+    text_cache::text_cache(std::size_t capacity)
+    :   _capacity{capacity == 0u ? 1u : capacity}
+    {
+    }
+
+    const text_metrics& text_cache::measure(NVGcontext *vg, int font_face, float font_size, std::string_view text)
+    {
+        //  NanoVG has no getter for the text alignment and letter spacing : the defaults are restored
+        nvgFontFaceId(vg, font_face);
+        nvgFontSize(vg, font_size);
+        nvgTextAlign(vg, NVG_ALIGN_LEFT | NVG_ALIGN_BASELINE);
+        nvgTextLetterSpacing(vg, 0.f);
+
+        //  A context created at the address of a deleted one does not hit its entries
+        const entry_key key{vg, nanovg_gl_context_id(vg), font_face, font_size, text_scale(vg), text};
+        const auto it = _index.find(key);
+
+        if (it != _index.end()) {
+            _hit_count++;
+            _entries.splice(_entries.begin(), _entries, it->second);
+            return it->second->metrics;
+        }
+
+        _miss_count++;
+
+        if (_entries.size() >= _capacity) {
+            _index.erase(_entries.back().key);
+            _entries.pop_back();
+        }
+
+        _entries.push_front(entry{key, std::string{text}, {}});
+
+        auto& e = _entries.front();
+        e.key.text = e.text;
+        _index.emplace(e.key, _entries.begin());
+
+        e.metrics.advance = nvgTextBounds(vg, 0.f, 0.f, e.text.data(), e.text.data() + e.text.size(), e.metrics.bounds);
+        return e.metrics;
+    }
+
+    void text_cache::clear() noexcept
+    {
+        _index.clear();
+        _entries.clear();
+    }
+
+    text_cache& thread_text_cache()
+    {
+        thread_local text_cache cache{};
+        return cache;
+    }
+
+}
@@ -0,0 +1,88 @@
+#ifndef VIEW_TEXT_CACHE_H_
+#define VIEW_TEXT_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <nanovg.h>
+
+namespace View {
+
+    /**
+     *  \brief Measured text : bounds as given by nvgTextBounds, for a text at (0, 0)
+     */
+    struct text_metrics {
+        float bounds[4];        /**< left, top, right, bottom */
+        float advance;          /**< Horizontal advance */
+    };
+
+    /**
+     *  \class text_cache
+     *  \brief Least recently used cache of text measurements
+     *  \details Entries are keyed by context (and its gl_renderer identifier), font face, font size,
+     *  transform scale (NanoVG measure text at the display resolution) and string.
+     *  A cache must only be used by one thread.
+     */
+    class text_cache {
+    public:
+        static constexpr std::size_t default_capacity = 1024u;
+
+        explicit text_cache(std::size_t capacity = default_capacity);
+
+        /**
+         *  \brief Set the font, the default text alignment (left, baseline) and letter spacing,
+         *  and return the metrics of a text
+         *  \note The returned reference is valid until the next call
+         */
+        const text_metrics& measure(NVGcontext *vg, int font_face, float font_size, std::string_view text);
+
+        void clear() noexcept;
+        std::size_t size() const noexcept { return _entries.size(); }
+        std::size_t capacity() const noexcept { return _capacity; }
+
+        std::uint64_t hit_count() const noexcept { return _hit_count; }
+        std::uint64_t miss_count() const noexcept { return _miss_count; }
+
+    private:
+        struct entry_key {
+            NVGcontext *vg;
+            std::uint64_t context_id;
+            int font_face;
+            float font_size;
+            float scale;
+            std::string_view text;      /**< View the entry text once stored */
+
+            bool operator==(const entry_key& other) const noexcept;
+        };
+
+        struct entry_key_hash {
+            std::size_t operator()(const entry_key& key) const noexcept;
+        };
+
+        struct entry {
+            entry_key key;
+            std::string text;
+            text_metrics metrics;
+        };
+
+        using entry_list = std::list<entry>;
+
+        const std::size_t _capacity;
+        entry_list _entries{};      /**< Most recently used first. The nodes, and their text, are never moved */
+        std::unordered_map<entry_key, entry_list::iterator, entry_key_hash> _index{};
+        std::uint64_t _hit_count{0u};
+        std::uint64_t _miss_count{0u};
+    };
+
+    /**
+     *  \brief Return the cache used by draw_text on the calling thread
+     */
+    text_cache& thread_text_cache();
+
+}
+
+#endif
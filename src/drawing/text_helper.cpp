@@ -1,4 +1,5 @@
 #include "text_helper.h"
+#include "text_cache.h"
 
 namespace View {
 
@@ -35,14 +36,11 @@ namespace View {
         horizontal_alignment ha,
         vertical_alignment va)
     {
-        float bounds[4]; // left, top, right, bottom
-
-        //  Set font
-        nvgFontFaceId(vg, bold ? 1 : 0);
-        nvgFontSize(vg, font_size);
+        //  Set font and measure (left, top, right, bottom) : strings rarely change between frames
+        const auto& metrics = thread_text_cache().measure(vg, bold ? 1 : 0, font_size, txt);
+        const auto *bounds = metrics.bounds;
 
         //  Compute pos
-        nvgTextBounds(vg, 0, 0, txt, nullptr, bounds);
         auto text_x_offset = compute_txt_x_offset(width, bounds, ha);
         auto text_y_offset = compute_txt_y_offset(height, bounds, va);
 
@@ -0,0 +1,199 @@
+
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__GNUG__)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+#include "draw_profiler.h"
+#include "widget/widget.h"
+
+namespace View {
+
+    namespace {
+
+        struct trace_record {
+            const char *call;
+            const std::string *name;
+            std::string path;
+            draw_profiler::clock::time_point begin;
+            draw_profiler::clock::duration duration;
+            unsigned int thread;
+        };
+
+        struct profiler_state {
+            std::mutex mutex{};
+            std::vector<trace_record> records{};
+            draw_profiler::clock::time_point origin{draw_profiler::clock::now()};
+
+            //  Node based : the names addresses are stable
+            std::unordered_map<std::type_index, std::string> type_names{};
+        };
+
+        profiler_state& state()
+        {
+            static profiler_state instance{};
+            return instance;
+        }
+
+        //  Names of the traced calls enclosing the current one, on this thread
+        thread_local std::vector<const std::string*> call_stack{};
+
+        unsigned int current_thread_index()
+        {
+            static std::atomic<unsigned int> next_index{1u};
+            thread_local const unsigned int index = next_index++;
+            return index;
+        }
+
+        std::string demangle(const char *name)
+        {
+#if defined(__GNUG__)
+            int status = 0;
+            char *demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+
+            if (demangled != nullptr) {
+                std::string result{demangled};
+                std::free(demangled);
+                return result;
+            }
+#endif
+            return name;
+        }
+
+        std::string type_name(const std::type_info& type)
+        {
+            //  Widgets all live in the View namespace : it does not help reading the trace
+            static const std::string prefix{"View::"};
+            auto name = demangle(type.name());
+
+            for (auto pos = name.find(prefix); pos != std::string::npos; pos = name.find(prefix, pos))
+                name.erase(pos, prefix.size());
+
+            return name;
+        }
+
+        void write_json_string(std::ostream& stream, const std::string& str)
+        {
+            stream << '"';
+            for (const auto c : str) {
+                if (c == '"' || c == '\\')
+                    stream << '\\';
+                stream << c;
+            }
+            stream << '"';
+        }
+
+    }
+
+    void draw_profiler::scope::_begin(const char *call, const widget& w)
+    {
+        auto& s = state();
+
+        {
+            const std::type_index type{typeid(w)};
+            std::lock_guard<std::mutex> lock{s.mutex};
+            auto it = s.type_names.find(type);
+
+            if (it == s.type_names.end())
+                it = s.type_names.emplace(type, type_name(typeid(w))).first;
+
+            _name = &(it->second);
+        }
+
+        _call = call;
+        _active = true;
+        call_stack.push_back(_name);
+        _begin_time = clock::now();
+    }
+
+    void draw_profiler::scope::_end()
+    {
+        const auto end_time = clock::now();
+
+        std::string path{};
+        for (const auto *name : call_stack) {
+            if (!path.empty())
+                path += '/';
+            path += *name;
+        }
+
+        call_stack.pop_back();
+
+        auto& s = state();
+        std::lock_guard<std::mutex> lock{s.mutex};
+        s.records.push_back({_call, _name, std::move(path), _begin_time, end_time - _begin_time, current_thread_index()});
+    }
+
+    void draw_profiler::start()
+    {
+        state();    //  Set the trace origin before the first record
+        _enabled.store(true);
+    }
+
+    void draw_profiler::stop() noexcept
+    {
+        _enabled.store(false);
+    }
+
+    void draw_profiler::clear()
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock{s.mutex};
+        s.records.clear();
+    }
+
+    std::size_t draw_profiler::record_count()
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock{s.mutex};
+        return s.records.size();
+    }
+
+    void draw_profiler::write_chrome_trace(std::ostream& stream)
+    {
+        using microseconds = std::chrono::duration<double, std::micro>;
+
+        auto& s = state();
+        std::lock_guard<std::mutex> lock{s.mutex};
+
+        stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool first = true;
+        for (const auto& record : s.records) {
+            if (!first)
+                stream << ',';
+            first = false;
+
+            stream << "\n{\"name\":";
+            write_json_string(stream, *record.name);
+            stream << ",\"cat\":\"" << record.call << "\""
+                << ",\"ph\":\"X\""
+                << ",\"ts\":" << microseconds{record.begin - s.origin}.count()
+                << ",\"dur\":" << microseconds{record.duration}.count()
+                << ",\"pid\":1,\"tid\":" << record.thread
+                << ",\"args\":{\"path\":";
+            write_json_string(stream, record.path);
+            stream << "}}";
+        }
+
+        stream << "\n]}\n";
+    }
+
+    void draw_profiler::save_chrome_trace(const std::string& path)
+    {
+        std::ofstream stream{path};
+
+        if (!stream)
+            throw std::runtime_error("View::draw_profiler : unable to open " + path);
+
+        write_chrome_trace(stream);
+    }
+
+}
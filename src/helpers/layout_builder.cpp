@@ -5,14 +5,17 @@ namespace View
 {
     layout_builder::layout_builder(
         float horizontal_step,
-        float vertical_step) noexcept
+        float vertical_step,
+        widget_arena *arena) noexcept
     :    _horizontal_step{horizontal_step},
-        _vertical_step{vertical_step}
+        _vertical_step{vertical_step},
+        _arena{arena}
     {
     }
 
     std::unique_ptr<View::header> layout_builder::header(std::unique_ptr<widget>&& child, color_theme::color background, float internal_border_size, float header_size, float border_size) const
     {
+        widget_arena::scope scope{_arena};
         return std::make_unique<View::header>(std::move(child), background, header_size, border_size, internal_border_size);
     }
 
@@ -23,6 +26,7 @@ namespace View
 
     std::unique_ptr<map_wrapper> layout_builder::map(std::unique_ptr<widget>&& child, float width, float height) const
     {
+        widget_arena::scope scope{_arena};
         return std::make_unique<map_wrapper>(std::move(child), width, height);
     }
 
@@ -33,6 +37,7 @@ namespace View
 
     std::unique_ptr<background> layout_builder::windows(std::unique_ptr<widget>&& child, float border_width, float border_heith) const
     {
+        widget_arena::scope scope{_arena};
         return std::make_unique<View::background>(
                      std::make_unique<border_wrapper>(
                         std::move(child),
@@ -42,6 +47,7 @@ namespace View
 
     std::unique_ptr<widget> layout_builder::empty_space(float width, float height, size_constraint width_constraint, size_constraint height_constraint) const
     {
+        widget_arena::scope scope{_arena};
         return std::make_unique<widget>(width, height, width_constraint, height_constraint);
     }
 }
\ No newline at end of file
@@ -3,12 +3,22 @@
 
 #include "../widget_container/border_wrapper.h"
 #include "../widget_container/pair_layout.h"
+#include "../widget_container/linear_layout.h"
 #include "../widget_container/header.h"
 #include "../widget_container/background.h"
 #include "../widget_container/map_wrapper.h"
+#include "../widget/widget_arena.h"
 
 namespace View {
 
+    /**
+     *  \brief Container used by the layout_builder to place widgets side by side
+     */
+    enum class layout_kind {
+        pair,       /**< Chain of pair_layout */
+        linear      /**< One linear_layout */
+    };
+
     namespace Details
     {
         template <orientation O, typename T>
@@ -66,20 +76,44 @@ namespace View {
                         xstep, ystep, std::move(lasts)...));
             }
         };
+
+        template <orientation O, bool Frozen, typename T, typename ...Ts>
+        auto build_spaced_linear_layout(float xstep, float ystep, T&& first, Ts&& ...lasts)
+        {
+            if constexpr (sizeof...(Ts) == 0)
+                return std::move(first);
+            else
+                return make_linear_layout<O, Frozen>(
+                    std::move(first),
+                    make_next_widget<O>(xstep, ystep, std::move(lasts))...);
+        }
     }
 
+    /**
+     *  \class layout_builder
+     *  \brief Build the usual widget compositions
+     *  \details If an arena is given, the widgets returned as std::unique_ptr are allocated in it
+     *  (see widget_arena). The shared widgets are always allocated on the heap.
+     *  horizontal and vertical emit a chain of pair_layout, or a flat linear_layout.
+     */
     class layout_builder
     {
     public:
         layout_builder(
             float horizontal_step = 3.f,
-            float vertical_step = 3.f) noexcept;
+            float vertical_step = 3.f,
+            widget_arena *arena = nullptr) noexcept;
 
-        template <bool Frozen = true, typename ...T>
+        template <bool Frozen = true, layout_kind Kind = layout_kind::pair, typename ...T>
         auto horizontal(T&& ...childs) const
         {
-            return Details::spaced_layout_builder<orientation::horizontal, Frozen, T...>::build(
-                _horizontal_step, _vertical_step, std::move(childs)...);
+            widget_arena::scope scope{_arena};
+            if constexpr (Kind == layout_kind::linear)
+                return Details::build_spaced_linear_layout<orientation::horizontal, Frozen>(
+                    _horizontal_step, _vertical_step, std::move(childs)...);
+            else
+                return Details::spaced_layout_builder<orientation::horizontal, Frozen, T...>::build(
+                    _horizontal_step, _vertical_step, std::move(childs)...);
         }
 
         template <bool Frozen = true, typename ...T>
@@ -89,11 +123,16 @@ namespace View {
                 _horizontal_step, _vertical_step, std::move(childs)...);
         }
 
-        template <bool Frozen = true, typename ...T>
+        template <bool Frozen = true, layout_kind Kind = layout_kind::pair, typename ...T>
         auto vertical(T&& ...childs) const
         {
-            return Details::spaced_layout_builder<orientation::vertical, Frozen, T...>::build(
-                _horizontal_step, _vertical_step, std::move(childs)...);
+            widget_arena::scope scope{_arena};
+            if constexpr (Kind == layout_kind::linear)
+                return Details::build_spaced_linear_layout<orientation::vertical, Frozen>(
+                    _horizontal_step, _vertical_step, std::move(childs)...);
+            else
+                return Details::spaced_layout_builder<orientation::vertical, Frozen, T...>::build(
+                    _horizontal_step, _vertical_step, std::move(childs)...);
         }
 
         template <bool Frozen = true, typename ...T>
@@ -128,6 +167,7 @@ namespace View {
     private:
         const float _horizontal_step;
         const float _vertical_step;
+        widget_arena *const _arena;
     };
 }
 
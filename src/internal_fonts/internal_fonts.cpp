@@ -1,5 +1,6 @@
 
 #include <cstdint>
+#include <string>
 
 #include "internal_fonts.h"
 
@@ -23,4 +24,30 @@ namespace View {
         return nvgCreateFontMem(vg, "", roboto_bold_ttf, roboto_bold_ttf_len, 0);
     }
 
+    void prerender_internal_fonts(NVGcontext *vg, float pixel_ratio, std::initializer_list<float> font_sizes)
+    {
+        static const auto printable_ascii = []()
+        {
+            std::string text{};
+            for (char c = 0x20; c < 0x7f; ++c)
+                text.push_back(c);
+            return text;
+        }();
+
+        //  Glyphs are rasterized and uploaded by nvgText : the drawing itself is discarded
+        nvgBeginFrame(vg, 1.f, 1.f, 1.f);
+        nvgScale(vg, pixel_ratio, pixel_ratio);
+
+        for (const auto font_face : {0, 1}) {
+            nvgFontFaceId(vg, font_face);
+
+            for (const auto size : font_sizes) {
+                nvgFontSize(vg, size);
+                nvgText(vg, 0.f, 0.f, printable_ascii.data(), printable_ascii.data() + printable_ascii.size());
+            }
+        }
+
+        nvgCancelFrame(vg);
+    }
+
 }
\ No newline at end of file
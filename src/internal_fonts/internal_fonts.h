@@ -1,6 +1,8 @@
 #ifndef VIEW_INTERNAL_FONT_H_
 #define VIEW_INTERNAL_FONT_H_
 
+#include <initializer_list>
+
 #include <nanovg.h>
 
 namespace View {
@@ -8,6 +10,22 @@ namespace View {
     int create_roboto_regular_font(NVGcontext*);
     int create_roboto_bold_font(NVGcontext*);
 
+    /**
+     *  \brief Font size used by default by the controls
+     */
+    constexpr auto default_font_size = 14.f;
+
+    /**
+     *  \brief Rasterize the printable ASCII glyphs of both internal fonts into the context font atlas
+     *  \details Glyphs are otherwise rasterized when first drawn, which stall the first frame.
+     *  Glyphs already in the atlas are not rasterized again.
+     *  Must be called with the OpenGL context current, outside of a NanoVG frame.
+     *  \param pixel_ratio display pixels per widget unit
+     */
+    void prerender_internal_fonts(
+        NVGcontext *vg, float pixel_ratio,
+        std::initializer_list<float> font_sizes = {default_font_size});
+
 }
 
 #endif
\ No newline at end of file
@@ -11,22 +11,22 @@
 
 namespace View
 {
-    static std::unique_ptr<view_backend> create_backend(widget& root, float pixel_per_unit)
+    static std::unique_ptr<view_backend> create_backend(widget& root, float pixel_per_unit, gl_version renderer)
     {
 #if defined(__linux__) || defined(__APPLE__)
-        return std::make_unique<x11_backend>(root, pixel_per_unit);
+        return std::make_unique<x11_backend>(root, pixel_per_unit, renderer);
 #elif defined _WIN32
         return std::make_unique<win32_backend>(root, pixel_per_unit);
 #endif
     }
 
-    std::unique_ptr<application_display> create_application_display(widget& root, float pixel_per_unit)
+    std::unique_ptr<application_display> create_application_display(widget& root, float pixel_per_unit, gl_version renderer)
     {
-        return std::make_unique<application_display>(create_backend(root, pixel_per_unit));
+        return std::make_unique<application_display>(create_backend(root, pixel_per_unit, renderer));
     }
 
-    std::unique_ptr<vst2_display> create_vst2_display(widget& root, float pixel_per_unit)
+    std::unique_ptr<vst2_display> create_vst2_display(widget& root, float pixel_per_unit, gl_version renderer)
     {
-        return std::make_unique<vst2_display>(create_backend(root, pixel_per_unit));
+        return std::make_unique<vst2_display>(create_backend(root, pixel_per_unit, renderer));
     }
 }
\ No newline at end of file
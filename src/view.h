@@ -4,16 +4,25 @@
 //  TODO multiplatform settup
 #include "display/frontends/application_display.h"
 #include "display/frontends/vst2_display.h"
+#include "display/common/gl_renderer.h"
+#ifdef VIEW_OFFSCREEN_BACKEND
+#include "display/backends/offscreen_backend.h"
+#endif
 #include "widget/widget.h"
 #include "widget/widget_proxy.h"
+#include "widget/widget_arena.h"
 
 //  Widget Container
 #include "widget_container/panel.h"
 #include "widget_container/pair_layout.h"
+#include "widget_container/linear_layout.h"
 #include "widget_container/header.h"
 #include "widget_container/background.h"
 #include "widget_container/map_wrapper.h"
 #include "widget_container/border_wrapper.h"
+#include "widget_container/cached_layer.h"
+#include "widget_container/display_list_wrapper.h"
+#include "widget_container/virtual_list.h"
 
 //  Controls
 #include "controls/label.h"
@@ -27,8 +36,11 @@
 
 namespace View {
 
-    std::unique_ptr<application_display> create_application_display(widget& root, float pixel_per_unit);
-    std::unique_ptr<vst2_display> create_vst2_display(widget& root, float pixel_per_unit);
+    /**
+     *  \param renderer requested NanoVG renderer (OpenGL 3 is only supported by the X11 backend)
+     */
+    std::unique_ptr<application_display> create_application_display(widget& root, float pixel_per_unit, gl_version renderer = gl_version::gl2);
+    std::unique_ptr<vst2_display> create_vst2_display(widget& root, float pixel_per_unit, gl_version renderer = gl_version::gl2);
 
 }
 
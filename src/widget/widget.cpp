@@ -1,5 +1,6 @@
 
 #include "widget.h"
+#include "widget_arena.h"
 #include "display/common/display_controler.h"
 
 namespace View {
@@ -26,6 +27,16 @@ namespace View {
             _display_ctl->_widget = nullptr;
     }
 
+    void *widget::operator new(std::size_t size)
+    {
+        return widget_arena::allocate_widget(size);
+    }
+
+    void widget::operator delete(void *ptr) noexcept
+    {
+        widget_arena::deallocate_widget(ptr);
+    }
+
     void widget::freeze_size()
     {
         _width_constraint = size_constraint{width(), width()};
@@ -1,6 +1,7 @@
 #ifndef VIEW_WIDGET_H_
 #define VIEW_WIDGET_H_
 
+#include <cstddef>
 #include <string_view>
 
 #include <nanovg.h>
@@ -9,6 +10,7 @@
 #include "event.h"
 #include "rectangle.h"
 #include "size_constraint.h"
+#include "widget_handle.h"
 
 namespace View {
 
@@ -17,6 +19,7 @@ namespace View {
     class widget {
         //  Note : widget is not a rectangle because it does not know its position
         friend class display_controler;
+        template <typename> friend class widget_handle;
     public:
         widget(float width, float height) noexcept;
         widget(float width, float height, size_constraint width_constraint, size_constraint height_constraint);
@@ -24,6 +27,12 @@ namespace View {
         widget(widget&) = delete;
         virtual ~widget();
 
+        /**
+         *  Widgets are allocated in the current widget_arena of the calling thread, if any
+         */
+        static void *operator new(std::size_t size);
+        static void operator delete(void *ptr) noexcept;
+
         float width() const noexcept    { return _width; }
         float height() const noexcept   { return _height; }
 
@@ -61,6 +70,12 @@ namespace View {
         virtual void draw(NVGcontext*) {}
         virtual void draw_rect(NVGcontext* vg, const rectangle<>&) { draw(vg); }
 
+        /**
+         *  \brief Area that the widget drawing entirely cover, in widget coordinates
+         *  \details Containers can skip drawing the siblings hidden behind it. Empty by default
+         */
+        virtual rectangle<> opaque_rect() const { return {}; }
+
         //  Color theme handling
         virtual void apply_color_theme(const color_theme& theme) {}
 
@@ -88,6 +103,7 @@ namespace View {
         float _height;
         size_constraint _width_constraint;
         size_constraint _height_constraint;
+        widget_slot _slot{};
     };
 
 }
@@ -0,0 +1,190 @@
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <new>
+
+#include "widget_arena.h"
+
+namespace View {
+
+    namespace {
+
+        thread_local widget_arena *current_arena = nullptr;
+
+        /**
+         *  Memory chunks of every arena, by address : a widget is allocated in an arena if its
+         *  address is in one of the arena chunks. No header is needed before the widgets.
+         */
+        struct chunk_registry {
+            struct chunk {
+                std::uintptr_t end;
+                void *arena_state;
+            };
+
+            std::mutex mutex{};
+            std::map<std::uintptr_t, chunk> chunks{};       /**< By chunk begin */
+            std::atomic<std::size_t> chunk_count{0u};       /**< Read without the lock */
+        };
+
+        chunk_registry& registry()
+        {
+            static chunk_registry instance{};
+            return instance;
+        }
+
+        void *find_arena_state(const void *ptr) noexcept
+        {
+            auto& r = registry();
+
+            //  No arena : every widget is on the heap
+            if (r.chunk_count.load(std::memory_order_acquire) == 0u)
+                return nullptr;
+
+            const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+            std::lock_guard<std::mutex> lock{r.mutex};
+            auto it = r.chunks.upper_bound(address);
+
+            if (it == r.chunks.begin())
+                return nullptr;
+
+            --it;
+            return (address < it->second.end) ? it->second.arena_state : nullptr;
+        }
+
+        /**
+         *  \brief Forward the chunk allocations of an arena to its upstream resource, and register them
+         */
+        class chunk_resource : public std::pmr::memory_resource {
+        public:
+            chunk_resource(void *arena_state, std::pmr::memory_resource *upstream) noexcept
+            :   _arena_state{arena_state}, _upstream{upstream}
+            {}
+
+        private:
+            void *do_allocate(std::size_t bytes, std::size_t alignment) override
+            {
+                auto *ptr = _upstream->allocate(bytes, alignment);
+                const auto begin = reinterpret_cast<std::uintptr_t>(ptr);
+                auto& r = registry();
+
+                try {
+                    std::lock_guard<std::mutex> lock{r.mutex};
+                    r.chunks.emplace(begin, chunk_registry::chunk{begin + bytes, _arena_state});
+                    r.chunk_count.fetch_add(1u, std::memory_order_release);
+                }
+                catch (...) {
+                    _upstream->deallocate(ptr, bytes, alignment);
+                    throw;
+                }
+
+                return ptr;
+            }
+
+            void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override
+            {
+                auto& r = registry();
+
+                {
+                    std::lock_guard<std::mutex> lock{r.mutex};
+                    r.chunks.erase(reinterpret_cast<std::uintptr_t>(ptr));
+                    r.chunk_count.fetch_sub(1u, std::memory_order_release);
+                }
+
+                _upstream->deallocate(ptr, bytes, alignment);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+
+            void *_arena_state;
+            std::pmr::memory_resource *_upstream;
+        };
+
+    }
+
+    struct widget_arena::state {
+        state(std::size_t initial_size, std::pmr::memory_resource *upstream)
+        :   chunks{this, upstream},
+            resource{initial_size, &chunks}
+        {}
+
+        chunk_resource chunks;      /**< Released after the buffer */
+        std::pmr::monotonic_buffer_resource resource;
+        std::size_t allocated_size{0u};
+        std::size_t widget_count{0u};
+        bool orphan{false};     /**< The arena was destroyed before its widgets */
+    };
+
+    widget_arena::widget_arena(std::size_t initial_size, std::pmr::memory_resource *upstream)
+    :   _state{std::make_unique<state>(initial_size, upstream)}
+    {
+    }
+
+    widget_arena::~widget_arena()
+    {
+        //  The widgets still alive keep the memory : it is released with the last one
+        if (_state->widget_count != 0u) {
+            _state->orphan = true;
+            (void)_state.release();
+        }
+    }
+
+    std::size_t widget_arena::allocated_size() const noexcept
+    {
+        return _state->allocated_size;
+    }
+
+    std::size_t widget_arena::widget_count() const noexcept
+    {
+        return _state->widget_count;
+    }
+
+    widget_arena::scope::scope(widget_arena *arena) noexcept
+    :   _previous{current_arena}
+    {
+        if (arena != nullptr)
+            current_arena = arena;
+    }
+
+    widget_arena::scope::~scope()
+    {
+        current_arena = _previous;
+    }
+
+    widget_arena *widget_arena::current() noexcept
+    {
+        return current_arena;
+    }
+
+    void *widget_arena::allocate_widget(std::size_t size)
+    {
+        if (current_arena == nullptr)
+            return ::operator new(size);
+
+        auto& arena_state = *current_arena->_state;
+        auto *ptr = arena_state.resource.allocate(size, alignof(std::max_align_t));
+        arena_state.allocated_size += size;
+        arena_state.widget_count++;
+
+        return ptr;
+    }
+
+    void widget_arena::deallocate_widget(void *ptr) noexcept
+    {
+        if (ptr == nullptr)
+            return;
+
+        auto *arena_state = static_cast<state*>(find_arena_state(ptr));
+
+        //  Arena memory is only released with the arena, or with its last widget
+        if (arena_state == nullptr)
+            ::operator delete(ptr);
+        else if (--arena_state->widget_count == 0u && arena_state->orphan)
+            delete arena_state;
+    }
+
+}
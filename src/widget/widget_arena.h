@@ -0,0 +1,78 @@
+#ifndef VIEW_WIDGET_ARENA_H_
+#define VIEW_WIDGET_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace View {
+
+    /**
+     *  \class widget_arena
+     *  \brief Memory where a widget tree is allocated contiguously
+     *  \details While a scope is open on a thread, the widgets created by this thread with new
+     *  (std::make_unique) are allocated in the arena. They are still owned and destroyed as
+     *  usual, but their memory is only given back when the arena is destroyed, in one shot.
+     *  Widgets created by std::make_shared are not allocated in the arena.
+     *  The arena should outlive its widgets : if it is destroyed first, its memory is given
+     *  back when the last of them is destroyed. The arena, and its widgets, must only be used
+     *  by one thread at a time.
+     */
+    class widget_arena {
+    public:
+        static constexpr std::size_t default_initial_size = 64u * 1024u;
+
+        explicit widget_arena(
+            std::size_t initial_size = default_initial_size,
+            std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+        widget_arena(const widget_arena&) = delete;
+        ~widget_arena();
+
+        /**
+         *  \class scope
+         *  \brief Allocate the widgets created by the calling thread in an arena, until the scope end
+         */
+        class scope {
+        public:
+            /**
+             *  \param arena if null, the current arena (if any) is kept
+             */
+            explicit scope(widget_arena *arena) noexcept;
+            scope(const scope&) = delete;
+            ~scope();
+
+        private:
+            widget_arena *_previous;
+        };
+
+        /**
+         *  \return the size allocated for widgets, including the released ones
+         */
+        std::size_t allocated_size() const noexcept;
+
+        /**
+         *  \return the number of widgets allocated in the arena and not yet destroyed
+         */
+        std::size_t widget_count() const noexcept;
+
+        /**
+         *  \return the arena of the calling thread, or nullptr
+         */
+        static widget_arena *current() noexcept;
+
+        /**
+         *  Allocation functions used by the widget class
+         */
+        static void *allocate_widget(std::size_t size);
+        static void deallocate_widget(void *ptr) noexcept;
+
+    private:
+        //  Referenced by the widgets : kept until the last widget is destroyed
+        struct state;
+
+        std::unique_ptr<state> _state;
+    };
+
+}
+
+#endif
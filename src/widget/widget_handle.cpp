@@ -0,0 +1,66 @@
+
+#include <mutex>
+#include <stdexcept>
+
+#include "widget_handle.h"
+
+namespace View {
+
+    namespace {
+
+        //  Never destroyed, as widgets can be released during the static destruction
+        struct free_list {
+            std::mutex mutex{};
+            std::uint32_t head{0u};
+            std::uint32_t slot_count{1u};   //  Slot 0 is the null slot
+        };
+
+        free_list& slots_free_list()
+        {
+            static auto& instance = *new free_list{};
+            return instance;
+        }
+
+    }
+
+    std::uint32_t handle_table::acquire(widget& target)
+    {
+        auto& list = slots_free_list();
+        std::lock_guard<std::mutex> lock{list.mutex};
+        std::uint32_t index;
+
+        if (list.head != 0u) {
+            index = list.head;
+            list.head = _slot(index).next_free;
+        }
+        else {
+            if (list.slot_count == chunk_size * max_chunk_count)
+                throw std::runtime_error("View::handle_table : no more widget handle slot");
+
+            index = list.slot_count++;
+
+            //  Allocate a new chunk when needed
+            auto& chunk = _chunks[index / chunk_size];
+            if (chunk.load(std::memory_order_relaxed) == nullptr)
+                chunk.store(new slot[chunk_size], std::memory_order_release);
+        }
+
+        _slot(index).target.store(&target, std::memory_order_relaxed);
+        return index;
+    }
+
+    void handle_table::release(std::uint32_t index) noexcept
+    {
+        auto& list = slots_free_list();
+        std::lock_guard<std::mutex> lock{list.mutex};
+        auto& s = _slot(index);
+
+        //  Invalidate the handles to the released widget
+        s.target.store(nullptr, std::memory_order_relaxed);
+        s.generation.store(s.generation.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+
+        s.next_free = list.head;
+        list.head = index;
+    }
+
+}
@@ -0,0 +1,143 @@
+#ifndef VIEW_WIDGET_HANDLE_H_
+#define VIEW_WIDGET_HANDLE_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace View {
+
+    class widget;
+
+    /**
+     *  \class handle_table
+     *  \brief Slots referenced by the widget handles
+     *  \details A slot is allocated to a widget when the first handle to it is taken, and is
+     *  released when the widget is destroyed : its generation is then incremented, so that the
+     *  handles to the destroyed widget resolve to null. Resolving a handle only read the slot,
+     *  without any atomic read-modify-write. The slots are never moved nor freed.
+     *  Slot 0 is the null slot.
+     */
+    class handle_table {
+    public:
+        static constexpr std::uint32_t chunk_size = 1024u;
+        static constexpr std::uint32_t max_chunk_count = 4096u;
+
+        /**
+         *  \brief Allocate a slot to a widget
+         *  \throw std::runtime_error if every slot is used
+         */
+        static std::uint32_t acquire(widget& target);
+        static void release(std::uint32_t index) noexcept;
+
+        static std::uint32_t generation(std::uint32_t index) noexcept
+        {
+            return _slot(index).generation.load(std::memory_order_relaxed);
+        }
+
+        static widget *resolve(std::uint32_t index, std::uint32_t generation) noexcept
+        {
+            if (index == 0u)
+                return nullptr;
+
+            const auto& slot = _slot(index);
+
+            if (slot.generation.load(std::memory_order_relaxed) == generation)
+                return slot.target.load(std::memory_order_relaxed);
+            else
+                return nullptr;
+        }
+
+    private:
+        struct slot {
+            std::atomic<widget*> target{nullptr};
+            std::atomic<std::uint32_t> generation{0u};
+            std::uint32_t next_free{0u};
+        };
+
+        static slot& _slot(std::uint32_t index) noexcept
+        {
+            return _chunks[index / chunk_size].load(std::memory_order_acquire)[index % chunk_size];
+        }
+
+        inline static std::atomic<slot*> _chunks[max_chunk_count]{};
+    };
+
+    /**
+     *  \class widget_slot
+     *  \brief Handle slot owned by a widget, released with it
+     */
+    class widget_slot {
+    public:
+        widget_slot() noexcept = default;
+        widget_slot(const widget_slot&) = delete;
+
+        //  A moved widget is a new widget : handles to the moved one become null
+        widget_slot(widget_slot&&) noexcept {}
+
+        ~widget_slot()
+        {
+            if (_index != 0u)
+                handle_table::release(_index);
+        }
+
+        std::uint32_t index(widget& owner)
+        {
+            if (_index == 0u)
+                _index = handle_table::acquire(owner);
+            return _index;
+        }
+
+    private:
+        std::uint32_t _index{0u};
+    };
+
+    /**
+     *  \class widget_handle
+     *  \brief Non owning reference to a widget, that resolve to null once the widget is destroyed
+     *  \details A handle is a slot index and the slot generation when the handle was taken.
+     *  Unlike a std::weak_ptr, resolving a handle does not lock anything, and any widget can
+     *  be referenced, whoever own it. As the widget tree, handles are not thread safe : a widget
+     *  must not be destroyed by a thread while an other resolve a handle to it.
+     */
+    template <typename TWidget = widget>
+    class widget_handle {
+    public:
+        widget_handle() noexcept = default;
+
+        widget_handle(TWidget& target)
+        :   _index{target._slot.index(target)},
+            _generation{handle_table::generation(_index)}
+        {}
+
+        /**
+         *  \return the referenced widget, or nullptr if it was destroyed
+         */
+        TWidget *get() const noexcept
+        {
+            return static_cast<TWidget*>(handle_table::resolve(_index, _generation));
+        }
+
+        TWidget *operator->() const noexcept { return get(); }
+        explicit operator bool() const noexcept { return get() != nullptr; }
+
+        void reset() noexcept
+        {
+            _index = 0u;
+            _generation = 0u;
+        }
+
+        bool operator==(const widget_handle& other) const noexcept
+        {
+            return _index == other._index && _generation == other._generation;
+        }
+
+        bool operator!=(const widget_handle& other) const noexcept { return !(*this == other); }
+
+    private:
+        std::uint32_t _index{0u};
+        std::uint32_t _generation{0u};
+    };
+
+}
+
+#endif
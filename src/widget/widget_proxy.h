@@ -23,24 +23,42 @@ namespace View {
 
         ~widget_proxy() override = default;
 
+        /**
+         *  \brief Display a widget owned elsewhere. The proxy is empty once the widget is destroyed
+         *  \details The widget is kept alive during the forwarded input events (buttons, keys,
+         *  wheel, drags, enter and exit) : it can be replaced and released from their handlers.
+         *  Drawing, resizing and mouse moves resolve the widget through its handle, without locking :
+         *  it must not be released from those calls.
+         */
         void set_widget(std::weak_ptr<TChildren> w)
         {
-            if (auto sptr = _children.lock())
-                sptr->on_mouse_exit();
-
-            _children = w;
-
             if (auto sptr = w.lock()) {
-                sptr->resize(width(), height());
-                display_controler::set_widget(*sptr);
+                _set_widget(*sptr);
+                _shared_children = w;
+                _shared = true;
+            }
+            else {
+                if (auto child = _lock())
+                    child->on_mouse_exit();
+                reset_widget();
             }
+        }
 
-            invalidate();
+        /**
+         *  \brief Display a widget owned elsewhere. The proxy is empty once the widget is destroyed
+         *  \details The widget is not kept alive during the forwarded calls : it must not be
+         *  destroyed from its own event handlers.
+         */
+        void set_widget(TChildren& w)
+        {
+            _set_widget(w);
         }
 
         void reset_widget()
         {
-            _children = {};
+            _children.reset();
+            _shared_children.reset();
+            _shared = false;
             display_controler::_detach();
             invalidate();
         }
@@ -49,10 +67,10 @@ namespace View {
         bool resize(float width, float height) override
         {
             if (widget::constraint_match_size(width, height)) {
-                if (auto sptr = _children.lock()) {
-                    if (sptr->constraint_match_size(width, height)) {
+                if (auto *child = _children.get()) {
+                    if (child->constraint_match_size(width, height)) {
                         widget::resize(width, height);
-                        sptr->resize(width, height);
+                        child->resize(width, height);
                         return true;
                     }
                     else {
@@ -73,40 +91,40 @@ namespace View {
 
         bool on_char_input(char c) override
         {
-            if (auto sptr = _children.lock())
-                return sptr->on_char_input(c);
+            if (auto child = _lock())
+                return child->on_char_input(c);
             else
                 return false;
         }
 
         bool on_mouse_enter() override
         {
-            if (auto sptr = _children.lock())
-                return sptr->on_mouse_enter();
+            if (auto child = _lock())
+                return child->on_mouse_enter();
             else
                 return false;
         }
 
         bool on_mouse_exit() override
         {
-            if (auto sptr = _children.lock())
-                return sptr->on_mouse_exit();
+            if (auto child = _lock())
+                return child->on_mouse_exit();
             else
                 return false;
         }
 
         bool on_mouse_move(float x, float y) override
         {
-            if (auto sptr = _children.lock())
-                return sptr->on_mouse_move(x, y);
+            if (auto *child = _children.get())
+                return child->on_mouse_move(x, y);
             else
                 return false;
         }
 
         bool on_mouse_wheel(float x, float y, float distance)  override
         {
-            if (auto sptr = _children.lock())
-                return sptr->on_mouse_wheel(x, y, distance);
+            if (auto child = _lock())
+                return child->on_mouse_wheel(x, y, distance);
             else
                 return false;
         }
@@ -114,81 +132,125 @@ namespace View {
 
         bool on_mouse_button_down(const mouse_button button, float x, float y) override
         {
-            if (auto sptr = _children.lock())
-                return sptr->on_mouse_button_down(button, x, y);
+            if (auto child = _lock())
+                return child->on_mouse_button_down(button, x, y);
             else
                 return false;
         }
 
         bool on_mouse_button_up(const mouse_button button, float x, float y) override
         {
-            if (auto sptr = _children.lock())
-                return sptr->on_mouse_button_up(button, x, y);
+            if (auto child = _lock())
+                return child->on_mouse_button_up(button, x, y);
             else
                 return false;
         }
 
         bool on_mouse_dbl_click(float x, float y) override
         {
-            if (auto sptr = _children.lock())
-                return sptr->on_mouse_dbl_click(x, y);
+            if (auto child = _lock())
+                return child->on_mouse_dbl_click(x, y);
             else
                 return false;
         }
 
         bool on_mouse_drag(const mouse_button button, float x, float y, float dx, float dy) override
         {
-            if (auto sptr = _children.lock())
-                return sptr->on_mouse_drag(button, x, y, dx, dy);
+            if (auto child = _lock())
+                return child->on_mouse_drag(button, x, y, dx, dy);
             else
                 return false;
         }
 
         bool on_mouse_drag_start(const mouse_button button, float x, float y) override
         {
-            if (auto sptr = _children.lock())
-                return sptr->on_mouse_drag_start(button, x, y);
+            if (auto child = _lock())
+                return child->on_mouse_drag_start(button, x, y);
             else
                 return false;
         }
 
         bool on_mouse_drag_end(const mouse_button button, float x, float y) override
         {
-            if (auto sptr = _children.lock())
-                return sptr->on_mouse_drag_end(button, x, y);
+            if (auto child = _lock())
+                return child->on_mouse_drag_end(button, x, y);
             else
                 return false;
         }
 
         bool on_mouse_drag_cancel() override
         {
-            if (auto sptr = _children.lock())
-                return sptr->on_mouse_drag_cancel();
+            if (auto child = _lock())
+                return child->on_mouse_drag_cancel();
             else
                 return false;
         }
 
         void draw(NVGcontext *vg) override
         {
-            if (auto sptr = _children.lock())
-                sptr->draw(vg);
+            if (auto *child = _children.get())
+                child->draw(vg);
         }
 
         void draw_rect(NVGcontext* vg, const rectangle<>& rect) override
         {
-            if (auto sptr = _children.lock())
-                sptr->draw_rect(vg, rect);
+            if (auto *child = _children.get())
+                child->draw_rect(vg, rect);
+        }
 
+        rectangle<> opaque_rect() const override
+        {
+            if (auto *child = _children.get())
+                return child->opaque_rect();
+            else
+                return {};
         }
 
         //  Color theme handling
         void apply_color_theme(const color_theme& theme) override
         {
-            if (auto sptr = _children.lock())
-                sptr->apply_color_theme(theme);
+            if (auto *child = _children.get())
+                child->apply_color_theme(theme);
         }
 
     private:
+        /**
+         *  \brief Child pointer, owning the child during an input event handler when it is shared
+         */
+        struct locked_child {
+            std::shared_ptr<TChildren> owner;
+            TChildren *child;
+
+            TChildren *operator->() const noexcept { return child; }
+            explicit operator bool() const noexcept { return child != nullptr; }
+        };
+
+        locked_child _lock() const
+        {
+            if (_shared) {
+                auto sptr = _shared_children.lock();
+                auto *child = sptr.get();
+                return {std::move(sptr), child};
+            }
+            else {
+                return {nullptr, _children.get()};
+            }
+        }
+
+        void _set_widget(TChildren& w)
+        {
+            if (auto child = _lock())
+                child->on_mouse_exit();
+
+            _children = widget_handle<TChildren>{w};     //  Also resolve a shared child on the hot paths
+            _shared_children.reset();
+            _shared = false;
+            w.resize(width(), height());
+            display_controler::set_widget(w);
+
+            invalidate();
+        }
+
         /* Dpy ctl interface */
         void invalidate_rect(const rectangle<>& rect) override
         {
@@ -206,7 +268,10 @@ namespace View {
                 dpy_ctl->set_cursor(c);
         }
 
-        std::weak_ptr<TChildren> _children{};
+        //  Resolved without locking. A shared child is also locked around the input event handlers
+        widget_handle<TChildren> _children{};
+        std::weak_ptr<TChildren> _shared_children{};
+        bool _shared{false};
     };
 
 }
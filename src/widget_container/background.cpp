@@ -12,6 +12,8 @@ namespace View {
 
     bool background::resize(float width, float height)
     {
+        draw_profiler::scope trace{"resize", *_root.get()};
+
         if (_root->resize(width, height))
         {
             widget_wrapper_base<background>::resize(width, height);
@@ -36,8 +38,11 @@ namespace View {
 
     void background::draw_rect(NVGcontext *vg, const rectangle<>& area)
     {
+        //  Only the damaged area is redrawn
+        nvgIntersectScissor(vg, area.left, area.top, area.width(), area.height());
+
         nvgBeginPath(vg);
-        nvgRect(vg, 0, 0, width(), height());
+        nvgRect(vg, area.left, area.top, area.width(), area.height());
         nvgFillColor(vg, _background_color);
         nvgFill(vg);
 
@@ -45,6 +50,14 @@ namespace View {
         widget_wrapper_base<background>::draw_rect(vg, area);
     }
 
+    rectangle<> background::opaque_rect() const
+    {
+        if (_background_color.a >= 1.f)
+            return make_rectangle(0.f, height(), 0.f, width());
+        else
+            return {};
+    }
+
     void background::apply_color_theme(const View::color_theme &theme)
     {
         //  apply on childrens
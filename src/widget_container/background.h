@@ -13,6 +13,7 @@ namespace View {
         bool resize(float width, float height) override;
         void draw(NVGcontext *) override;
         void draw_rect(NVGcontext *, const rectangle<>& area) override;
+        rectangle<> opaque_rect() const override;
 
         void apply_color_theme(const color_theme &theme) override;
     private:
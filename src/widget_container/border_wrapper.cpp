@@ -40,6 +40,7 @@ namespace View {
     {
         const auto width_offset = _border_left + _border_right;
         const auto height_offset = _border_top + _border_bottom;
+        draw_profiler::scope trace{"resize", *_root.get()};
 
         if (_root->resize(width - width_offset, height - height_offset)) {
             widget_wrapper_base<border_wrapper>::resize(width, height);
@@ -0,0 +1,216 @@
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+#include "cached_layer.h"
+#include "display/common/layer_surface.h"
+
+namespace View {
+
+    namespace {
+
+        struct pending_layer {
+            cached_layer *layer;
+            NVGcontext *vg;
+        };
+
+        //  Layers waiting to be rendered, and surfaces of destroyed layers waiting
+        //  for their context to be current to be released. Layers can be destroyed from any thread.
+        struct layer_registry {
+            std::mutex mutex{};
+            std::vector<pending_layer> pending{};
+            std::vector<std::unique_ptr<layer_surface>> released{};
+        };
+
+        layer_registry& registry()
+        {
+            static layer_registry instance{};
+            return instance;
+        }
+
+        float current_pixel_scale(NVGcontext *vg)
+        {
+            float transform[6];
+            nvgCurrentTransform(vg, transform);
+            return std::sqrt(transform[0] * transform[0] + transform[1] * transform[1]);
+        }
+
+    }
+
+    cached_layer::cached_layer(std::unique_ptr<widget>&& root)
+    :   base{std::move(root)}
+    {
+        //  Rendered by the displays after each frame
+        static const bool registered = (register_layer_renderer(render_pending_layers), true);
+        (void)registered;
+    }
+
+    cached_layer::~cached_layer()
+    {
+        auto& r = registry();
+        std::lock_guard<std::mutex> lock{r.mutex};
+
+        r.pending.erase(
+            std::remove_if(r.pending.begin(), r.pending.end(),
+                [this](const auto& p) { return p.layer == this; }),
+            r.pending.end());
+
+        if (_surface)
+            r.released.push_back(std::move(_surface));
+    }
+
+    bool cached_layer::resize(float width, float height)
+    {
+        if (_root->resize(width, height)) {
+            base::resize(width, height);
+            invalidate_cache();
+            return true;
+        }
+        else {
+            return false;
+        }
+    }
+
+    void cached_layer::draw(NVGcontext *vg)
+    {
+        const auto pixel_scale = current_pixel_scale(vg);
+
+        if (_can_composite(vg, pixel_scale)) {
+            _composite(vg);
+        }
+        else {
+            base::draw(vg);
+            _request_render(vg, pixel_scale);
+        }
+    }
+
+    void cached_layer::draw_rect(NVGcontext *vg, const rectangle<>& area)
+    {
+        const auto pixel_scale = current_pixel_scale(vg);
+
+        if (_can_composite(vg, pixel_scale)) {
+            //  The caller scissor restrict the drawing to the area
+            _composite(vg);
+        }
+        else {
+            base::draw_rect(vg, area);
+            _request_render(vg, pixel_scale);
+        }
+    }
+
+    void cached_layer::apply_color_theme(const color_theme& theme)
+    {
+        base::apply_color_theme(theme);
+        invalidate_cache();
+    }
+
+    void cached_layer::invalidate_cache() noexcept
+    {
+        _cached.store(false);
+    }
+
+    void cached_layer::render_pending_layers(NVGcontext *vg)
+    {
+        std::vector<cached_layer*> layers{};
+        std::vector<std::unique_ptr<layer_surface>> released{};
+
+        {
+            auto& r = registry();
+            std::lock_guard<std::mutex> lock{r.mutex};
+
+            for (auto it = r.pending.begin(); it != r.pending.end();) {
+                if (it->vg == vg) {
+                    layers.push_back(it->layer);
+                    it = r.pending.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+
+            //  Surfaces whose context is current, or whose context was destroyed
+            for (auto it = r.released.begin(); it != r.released.end();) {
+                if ((*it)->context() == vg || !(*it)->valid()) {
+                    released.push_back(std::move(*it));
+                    it = r.released.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+        }
+
+        //  Rendering is done on the drawing thread, which own the widget tree
+        for (auto *layer : layers)
+            layer->_render(vg);
+    }
+
+    bool cached_layer::_can_composite(NVGcontext *vg, float pixel_scale) const
+    {
+        return _cached.load() &&
+            _surface != nullptr &&
+            _surface->context() == vg &&
+            _surface->valid() &&
+            _pixel_scale == pixel_scale;
+    }
+
+    void cached_layer::_composite(NVGcontext *vg)
+    {
+        const auto paint = nvgImagePattern(vg, 0.f, 0.f, width(), height(), 0.f, _surface->image(), 1.f);
+
+        nvgBeginPath(vg);
+        nvgRect(vg, 0.f, 0.f, width(), height());
+        nvgFillPaint(vg, paint);
+        nvgFill(vg);
+    }
+
+    void cached_layer::_request_render(NVGcontext *vg, float pixel_scale)
+    {
+        _pixel_scale = pixel_scale;
+
+        auto& r = registry();
+        std::lock_guard<std::mutex> lock{r.mutex};
+
+        const auto already_pending = std::any_of(r.pending.begin(), r.pending.end(),
+            [this, vg](const auto& p) { return p.layer == this && p.vg == vg; });
+
+        if (!already_pending)
+            r.pending.push_back({this, vg});
+    }
+
+    void cached_layer::_render(NVGcontext *vg)
+    {
+        const auto pixel_width = static_cast<unsigned int>(std::ceil(width() * _pixel_scale));
+        const auto pixel_height = static_cast<unsigned int>(std::ceil(height() * _pixel_scale));
+
+        if (pixel_width == 0u || pixel_height == 0u)
+            return;
+
+        //  The previous surface belong to another context : release it when that context is current
+        if (_surface && _surface->context() != vg && _surface->valid()) {
+            auto& r = registry();
+            std::lock_guard<std::mutex> lock{r.mutex};
+            r.released.push_back(std::move(_surface));
+        }
+        else if (_surface && !_surface->valid()) {
+            _surface.reset();
+        }
+
+        if (!_surface)
+            _surface = std::make_unique<layer_surface>(vg);
+
+        //  The subtree is drawn directly until a surface can be allocated
+        if (!_surface->begin(pixel_width, pixel_height))
+            return;
+
+        //  Invalidation received while rendering will be rendered again
+        _cached.store(true);
+
+        nvgScale(vg, _pixel_scale, _pixel_scale);
+        base::draw(vg);
+        _surface->end();
+    }
+
+}
@@ -0,0 +1,63 @@
+#ifndef VIEW_CACHED_LAYER_H_
+#define VIEW_CACHED_LAYER_H_
+
+#include <atomic>
+#include <memory>
+
+#include "widget_wrapper_base.h"
+#include "invalidation_holder.h"
+
+namespace View {
+
+    class layer_surface;
+
+    /**
+     *  \class cached_layer
+     *  \brief Render a subtree once into an image, and draw this image until the subtree is invalidated
+     *  \details Suited to large and mostly static subtrees, whose drawing (gradients, shadows, text)
+     *  cost much more than compositing an image. When invalidated, the subtree is drawn directly
+     *  during the frame, and rendered into the layer once the frame is done.
+     *  The image has the pixel resolution of the display, but as it is composited with a linear filter,
+     *  a layer placed at a fractional pixel position looks slightly blurred.
+     */
+    class cached_layer : public widget_wrapper_base<cached_layer, invalidation_holder<cached_layer>> {
+        using base = widget_wrapper_base<cached_layer, invalidation_holder<cached_layer>>;
+    public:
+        explicit cached_layer(std::unique_ptr<widget>&& root);
+        ~cached_layer() override;
+
+        bool resize(float width, float height) override;
+        void draw(NVGcontext *vg) override;
+        void draw_rect(NVGcontext *vg, const rectangle<>& area) override;
+        void apply_color_theme(const color_theme& theme) override;
+
+        /**
+         *  \brief Drop the cached image : the subtree will be rendered again (can be called from any thread)
+         */
+        void invalidate_cache() noexcept;
+
+        /**
+         *  \brief Return true if the next draw will use the cached image
+         */
+        bool is_cached() const noexcept { return _cached.load(); }
+
+        /**
+         *  \brief Render the layers invalidated during the last frame drawn with this context
+         *  \note Registered as a layer renderer : called by render_layers after each frame, with the OpenGL context current
+         */
+        static void render_pending_layers(NVGcontext *vg);
+
+    private:
+        bool _can_composite(NVGcontext *vg, float pixel_scale) const;
+        void _composite(NVGcontext *vg);
+        void _request_render(NVGcontext *vg, float pixel_scale);
+        void _render(NVGcontext *vg);
+
+        std::unique_ptr<layer_surface> _surface{};
+        std::atomic<bool> _cached{false};
+        float _pixel_scale{1.f};
+    };
+
+}
+
+#endif
@@ -0,0 +1,73 @@
+
+#include <algorithm>
+
+#include "display_list_wrapper.h"
+#include "display/common/gl_renderer.h"
+
+namespace View {
+
+    display_list_wrapper::display_list_wrapper(std::unique_ptr<widget>&& root)
+    :   base{std::move(root)}
+    {
+    }
+
+    bool display_list_wrapper::resize(float width, float height)
+    {
+        if (_root->resize(width, height)) {
+            base::resize(width, height);
+            invalidate_cache();
+            return true;
+        }
+        else {
+            return false;
+        }
+    }
+
+    void display_list_wrapper::draw(NVGcontext *vg)
+    {
+        float transform[6];
+        nvgCurrentTransform(vg, transform);
+
+        if (_can_replay(vg, transform) && _list.replay(vg))
+            return;
+
+        //  Invalidation received while recording will drop the recording
+        _recorded.store(true);
+        _list.clear();
+
+        {
+            display_list::recorder recording{_list, vg};
+            base::draw(vg);
+        }
+
+        _context = vg;
+        _context_id = nanovg_gl_context_id(vg);
+        std::copy(transform, transform + 6, _transform);
+    }
+
+    void display_list_wrapper::draw_rect(NVGcontext *vg, const rectangle<>&)
+    {
+        //  The whole subtree is recorded, the caller scissor restrict the drawing to the area
+        draw(vg);
+    }
+
+    void display_list_wrapper::apply_color_theme(const color_theme& theme)
+    {
+        base::apply_color_theme(theme);
+        invalidate_cache();
+    }
+
+    void display_list_wrapper::invalidate_cache() noexcept
+    {
+        _recorded.store(false);
+    }
+
+    bool display_list_wrapper::_can_replay(NVGcontext *vg, const float *transform) const noexcept
+    {
+        return _recorded.load() &&
+            vg == _context &&
+            nanovg_gl_context_id(vg) == _context_id &&
+            std::equal(transform, transform + 6, _transform);
+    }
+
+}
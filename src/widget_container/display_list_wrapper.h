@@ -0,0 +1,62 @@
+#ifndef VIEW_DISPLAY_LIST_WRAPPER_H_
+#define VIEW_DISPLAY_LIST_WRAPPER_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "widget_wrapper_base.h"
+#include "invalidation_holder.h"
+#include "drawing/display_list.h"
+
+namespace View {
+
+    /**
+     *  \class display_list_wrapper
+     *  \brief Record the rendering commands of a subtree, and replay them until the subtree is invalidated
+     *  \details Unlike cached_layer, the subtree is still rasterized at each frame, but its drawing
+     *  code, path building and tessellation are skipped. The recording is dropped when the subtree
+     *  is invalidated, resized, receive a new color theme or is drawn with another transform, or with
+     *  another scissor when the subtree set its own scissors.
+     *  Existing widgets need no change : the commands are captured from the NanoVG context.
+     */
+    class display_list_wrapper : public widget_wrapper_base<display_list_wrapper, invalidation_holder<display_list_wrapper>> {
+        using base = widget_wrapper_base<display_list_wrapper, invalidation_holder<display_list_wrapper>>;
+    public:
+        explicit display_list_wrapper(std::unique_ptr<widget>&& root);
+        ~display_list_wrapper() override = default;
+
+        bool resize(float width, float height) override;
+        void draw(NVGcontext *vg) override;
+        void draw_rect(NVGcontext *vg, const rectangle<>& area) override;
+        void apply_color_theme(const color_theme& theme) override;
+
+        /**
+         *  \brief Drop the recording (can be called from any thread)
+         */
+        void invalidate_cache() noexcept;
+
+        /**
+         *  \brief Return true if the subtree drawing is recorded
+         */
+        bool is_recorded() const noexcept { return _recorded.load(); }
+
+        /**
+         *  \brief Return the recorded commands
+         */
+        const display_list& recording() const noexcept { return _list; }
+
+    private:
+        bool _can_replay(NVGcontext *vg, const float *transform) const noexcept;
+
+        display_list _list{};
+        std::atomic<bool> _recorded{false};
+
+        //  Recording key
+        std::uint64_t _context_id{0u};
+        NVGcontext *_context{nullptr};
+        float _transform[6]{};
+    };
+
+}
+
+#endif
@@ -0,0 +1,171 @@
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "grid_index.h"
+
+namespace View {
+
+    namespace {
+
+        std::int32_t cell_coordinate(float position, float cell_size)
+        {
+            constexpr auto limit = static_cast<float>(std::numeric_limits<std::int32_t>::max() / 2);
+            const auto cell = std::floor(position / cell_size);
+
+            if (std::isnan(cell))
+                return 0;
+            else
+                return static_cast<std::int32_t>(std::clamp(cell, -limit, limit));
+        }
+
+        void insert_sorted(std::vector<std::size_t>& ids, std::size_t id)
+        {
+            //  Insertion at the end is the common case
+            if (ids.empty() || ids.back() < id)
+                ids.push_back(id);
+            else
+                ids.insert(std::lower_bound(ids.begin(), ids.end(), id), id);
+        }
+
+        void remove_sorted(std::vector<std::size_t>& ids, std::size_t id)
+        {
+            const auto it = std::lower_bound(ids.begin(), ids.end(), id);
+            if (it != ids.end() && *it == id)
+                ids.erase(it);
+        }
+
+        //  Merge a sorted list into a sorted list without duplicate
+        void merge_unique(std::vector<std::size_t>& ids, const std::vector<std::size_t>& other)
+        {
+            const auto middle = ids.size();
+            ids.insert(ids.end(), other.begin(), other.end());
+            std::inplace_merge(ids.begin(), ids.begin() + middle, ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        }
+
+    }
+
+    grid_index::grid_index(float cell_size)
+    :   _cell_size{cell_size}
+    {
+    }
+
+    void grid_index::insert(std::size_t id, const rectangle<>& bounds)
+    {
+        if (id >= _bounds.size()) {
+            _bounds.resize(id + 1u);
+            _indexed.resize(id + 1u, false);
+        }
+        else if (_indexed[id]) {
+            if (_bounds[id].top == bounds.top && _bounds[id].bottom == bounds.bottom &&
+                _bounds[id].left == bounds.left && _bounds[id].right == bounds.right)
+                return;
+
+            _remove(id, _cells_of(_bounds[id]));
+        }
+
+        _bounds[id] = bounds;
+        _indexed[id] = true;
+        _add(id, _cells_of(bounds));
+    }
+
+    void grid_index::clear() noexcept
+    {
+        _cells.clear();
+        _large.clear();
+        _bounds.clear();
+        _indexed.clear();
+    }
+
+    void grid_index::at(float x, float y, std::vector<std::size_t>& ids) const
+    {
+        ids.clear();
+
+        const auto it = _cells.find(_cell_key(cell_coordinate(x, _cell_size), cell_coordinate(y, _cell_size)));
+
+        if (it != _cells.end())
+            ids = it->second;
+
+        merge_unique(ids, _large);
+    }
+
+    void grid_index::overlapping(const rectangle<>& area, std::vector<std::size_t>& ids) const
+    {
+        ids.clear();
+
+        const auto range = _cells_of(area);
+
+        //  Only visit the cells that exist when the area is large
+        if (range.large() && _cells.size() < static_cast<std::size_t>(range.right - range.left + 1) * (range.bottom - range.top + 1)) {
+            for (const auto& cell : _cells)
+                ids.insert(ids.end(), cell.second.begin(), cell.second.end());
+        }
+        else {
+            for (auto row = range.top; row <= range.bottom; ++row) {
+                for (auto column = range.left; column <= range.right; ++column) {
+                    const auto it = _cells.find(_cell_key(column, row));
+                    if (it != _cells.end())
+                        ids.insert(ids.end(), it->second.begin(), it->second.end());
+                }
+            }
+        }
+
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        merge_unique(ids, _large);
+    }
+
+    bool grid_index::cell_range::large() const noexcept
+    {
+        const auto width = static_cast<std::int64_t>(right) - left + 1;
+        const auto height = static_cast<std::int64_t>(bottom) - top + 1;
+        return width * height > static_cast<std::int64_t>(max_cells_per_rectangle);
+    }
+
+    grid_index::cell_range grid_index::_cells_of(const rectangle<>& bounds) const noexcept
+    {
+        return {
+            cell_coordinate(bounds.left, _cell_size), cell_coordinate(bounds.top, _cell_size),
+            cell_coordinate(bounds.right, _cell_size), cell_coordinate(bounds.bottom, _cell_size)};
+    }
+
+    void grid_index::_add(std::size_t id, const cell_range& range)
+    {
+        if (range.large()) {
+            insert_sorted(_large, id);
+            return;
+        }
+
+        for (auto row = range.top; row <= range.bottom; ++row)
+            for (auto column = range.left; column <= range.right; ++column)
+                insert_sorted(_cells[_cell_key(column, row)], id);
+    }
+
+    void grid_index::_remove(std::size_t id, const cell_range& range)
+    {
+        if (range.large()) {
+            remove_sorted(_large, id);
+            return;
+        }
+
+        for (auto row = range.top; row <= range.bottom; ++row) {
+            for (auto column = range.left; column <= range.right; ++column) {
+                const auto it = _cells.find(_cell_key(column, row));
+
+                if (it != _cells.end()) {
+                    remove_sorted(it->second, id);
+                    if (it->second.empty())
+                        _cells.erase(it);
+                }
+            }
+        }
+    }
+
+    std::uint64_t grid_index::_cell_key(std::int32_t column, std::int32_t row) noexcept
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(column)) << 32u) | static_cast<std::uint32_t>(row);
+    }
+
+}
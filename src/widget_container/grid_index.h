@@ -0,0 +1,65 @@
+#ifndef VIEW_GRID_INDEX_H_
+#define VIEW_GRID_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "widget/rectangle.h"
+
+namespace View {
+
+    /**
+     *  \class grid_index
+     *  \brief Uniform grid of rectangles, used to find the children of a container at a position
+     *  \details Rectangles are identified by their index in the container. Each grid cell list the
+     *  rectangles that touch it (edges included, as with widget::contains), ordered by identifier.
+     *  Rectangles covering too many cells are kept aside and checked by every query.
+     */
+    class grid_index {
+    public:
+        static constexpr float default_cell_size = 64.f;
+        static constexpr std::size_t max_cells_per_rectangle = 64u;
+
+        explicit grid_index(float cell_size = default_cell_size);
+
+        /**
+         *  \brief Add a rectangle, or update it if the identifier is already indexed
+         */
+        void insert(std::size_t id, const rectangle<>& bounds);
+
+        void clear() noexcept;
+        std::size_t size() const noexcept { return _bounds.size(); }
+
+        /**
+         *  \brief Fill ids with the rectangles that may contain a position, in increasing order
+         */
+        void at(float x, float y, std::vector<std::size_t>& ids) const;
+
+        /**
+         *  \brief Fill ids with the rectangles that may overlap an area, in increasing order
+         */
+        void overlapping(const rectangle<>& area, std::vector<std::size_t>& ids) const;
+
+    private:
+        struct cell_range {
+            std::int32_t left, top, right, bottom;
+            bool large() const noexcept;
+        };
+
+        cell_range _cells_of(const rectangle<>& bounds) const noexcept;
+        void _add(std::size_t id, const cell_range& range);
+        void _remove(std::size_t id, const cell_range& range);
+        static std::uint64_t _cell_key(std::int32_t column, std::int32_t row) noexcept;
+
+        const float _cell_size;
+        std::unordered_map<std::uint64_t, std::vector<std::size_t>> _cells{};
+        std::vector<std::size_t> _large{};
+        std::vector<rectangle<>> _bounds{};
+        std::vector<bool> _indexed{};
+    };
+
+}
+
+#endif
@@ -34,6 +34,7 @@ namespace View {
     bool header::resize(float w, float h)
     {
         const auto border_offset = 2.f * (_border + _internal_border);
+        draw_profiler::scope trace{"resize", *_root.get()};
 
         if (width_constraint().contains(w) &&
             height_constraint().contains(h))
@@ -52,6 +53,42 @@ namespace View {
     }
 
     void header::draw(NVGcontext *vg)
+    {
+        _draw_frame(vg);
+
+        //  Draw child
+        widget_wrapper_base<header>::draw(vg);
+    }
+
+    void header::draw_rect(NVGcontext *vg, const rectangle<>& area)
+    {
+        //  Only the damaged area is redrawn
+        nvgIntersectScissor(vg, area.left, area.top, area.width(), area.height());
+        _draw_frame(vg);
+
+        //  Draw the child part that overlap with area
+        widget_wrapper_base<header>::draw_rect(vg, area);
+    }
+
+    rectangle<> header::opaque_rect() const
+    {
+        //  Everything but the rounded corners
+        const auto rect_radius = _header_size / 3;
+
+        if (_header_color.a >= 1.f && _background_color.a >= 1.f)
+            return make_rectangle(rect_radius, height() - rect_radius, 0.f, width());
+        else
+            return {};
+    }
+
+    void header::apply_color_theme(const View::color_theme &theme)
+    {
+        widget_wrapper_base<header>::apply_color_theme(theme);
+        _header_color = theme.primary;
+        _background_color = theme.get(_background_color_id);
+    }
+
+    void header::_draw_frame(NVGcontext *vg)
     {
         const auto rect_radius = _header_size / 3;
 
@@ -79,40 +116,6 @@ namespace View {
             _border, _header_size + _border,
             _root->width() + 2.f * _internal_border,
             _root->height() + 2.f * _internal_border);
-
-        //  Draw child
-        widget_wrapper_base<header>::draw(vg);
-    }
-
-    void header::draw_rect(NVGcontext *vg, const rectangle<>& area)
-    {
-        auto root_area =
-            make_rectangle(
-                _header_size + _border, _header_size + _border + 2.f * _internal_border + _root->height(),
-                _border, _border + 2.f * _internal_border + _root->width());
-
-        if (root_area.contains(area))
-        {
-            //  Draw background on area (Header footer ???)
-            nvgRect(vg, area.left, area.top, area.width(), area.height());
-            nvgFillColor(vg, _background_color);
-            nvgFill(vg);
-
-            //  Draw content on area
-            draw_widgets(vg, area);
-        }
-        else
-        {
-            //  Redraw Everything : TODO optimize me !!
-            draw(vg);
-        }
-    }
-
-    void header::apply_color_theme(const View::color_theme &theme)
-    {
-        widget_wrapper_base<header>::apply_color_theme(theme);
-        _header_color = theme.primary;
-        _background_color = theme.get(_background_color_id);
     }
 
 }
\ No newline at end of file
@@ -16,9 +16,15 @@ namespace View {
         bool resize(float width, float height) override;
         void draw(NVGcontext *vg) override;
         void draw_rect(NVGcontext *vg, const rectangle<>&) override;
+        rectangle<> opaque_rect() const override;
 
         void apply_color_theme(const color_theme& theme) override;
     private:
+        /**
+         *  \brief Draw the header and the background, and clip to the background
+         */
+        void _draw_frame(NVGcontext *vg);
+
         const float _header_size;
         const float _border;
         const float _internal_border;
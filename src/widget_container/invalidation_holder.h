@@ -0,0 +1,35 @@
+#ifndef VIEW_INVALIDATION_HOLDER_H_
+#define VIEW_INVALIDATION_HOLDER_H_
+
+#include "widget_container.h"
+
+namespace View {
+
+    /**
+     *  \class invalidation_holder
+     *  \brief Widget holder that notify its owner when the held subtree need to be redrawn
+     *  \details Used by the wrappers that cache the drawing of their subtree : TOwner::invalidate_cache
+     *  is called before the invalidation is forwarded to the display.
+     */
+    template <typename TOwner>
+    class invalidation_holder : public widget_holder<> {
+    public:
+        invalidation_holder(TOwner& owner, float x, float y, std::unique_ptr<widget>&& w)
+        :   widget_holder<>{owner, x, y, std::move(w)},
+            _owner{owner}
+        {}
+
+    protected:
+        void invalidate_rect(const rectangle<>& rect) override
+        {
+            _owner.invalidate_cache();
+            widget_holder<>::invalidate_rect(rect);
+        }
+
+    private:
+        TOwner& _owner;
+    };
+
+}
+
+#endif
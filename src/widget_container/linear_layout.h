@@ -0,0 +1,337 @@
+#ifndef VIEW_LINEAR_LAYOUT_H_
+#define VIEW_LINEAR_LAYOUT_H_
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "widget_container.h"
+#include "layout_separator.h"
+
+namespace View {
+
+    /**
+     *  \class linear_layout
+     *  \brief Place any number of widgets side by side along an orientation
+     *  \details Behave as a chain of pair_layout (see make_layout), without the nesting : the
+     *  children are stored in one array, their positions are kept sorted so that hit testing
+     *  is a binary search, and a resize is distributed in one pass, from the last child to
+     *  the first. A separator between two children resize the first one and the following ones.
+     */
+    template <orientation Orientation>
+    class linear_layout : public widget_container<linear_layout<Orientation>> {
+        friend class widget_container<linear_layout<Orientation>>;
+        using base = widget_container<linear_layout<Orientation>>;
+
+        static constexpr auto _separator_width = 14.f;
+
+    public:
+        /**
+         *  \throw std::runtime_error if children is empty
+         */
+        explicit linear_layout(std::vector<std::unique_ptr<widget>>&& children)
+        :   base{_layout_width(children), _layout_height(children)}
+        {
+            if (children.empty())
+                throw std::runtime_error("View::linear_layout : no children");
+
+            const auto count = children.size();
+            size_constraint orientation_constraint{0.f, 0.f};
+            size_constraint orthogonal_constraint = free_size;
+
+            _children.reserve(count);
+            _separators.reserve(count - 1u);
+            _offsets.resize(count + 1u);
+
+            for (auto& child : children) {
+                orientation_constraint += _constraint(*child);
+                orthogonal_constraint = orthogonal_constraint.intersect(_orthogonal_constraint(*child));
+                _children.emplace_back(*this, 0.f, 0.f, std::move(child));
+            }
+
+            if constexpr (Orientation == orientation::horizontal)
+                base::set_size_constraints(orientation_constraint, orthogonal_constraint);
+            else
+                base::set_size_constraints(orthogonal_constraint, orientation_constraint);
+
+            //  Create the separators
+            const auto orthogonal_size = _orthogonal_size(*this);
+
+            for (auto i = 0u; i + 1u < count; ++i) {
+                auto separator = std::make_unique<layout_separator>(0.f, 0.f, orthogonal(Orientation));
+                separator->set_callback([this, i](float delta) { _on_separator_drag(i, delta); });
+                _resize(*separator, _separator_width, orthogonal_size);
+                _separators.emplace_back(*this, 0.f, 0.f, std::move(separator));
+            }
+
+            //  Set childrens sizes and positions
+            for (auto& child : _children)
+                _resize_clamp_orthogonal(*child.get(), orthogonal_size);
+
+            _update_positions();
+        }
+
+        ~linear_layout() override = default;
+
+        bool resize(float width, float height) override
+        {
+            if (base::width_constraint().contains(width) &&
+                base::height_constraint().contains(height))
+            {
+                const auto target_orientation_size = _choose_dim(width, height);
+                const auto target_orthogonal_size = _choose_dim_orthogonal(width, height);
+                auto orientation_delta = target_orientation_size - _size(*this);
+
+                //  Resize the last children as much as possible, and then the previous ones
+                if (orientation_delta != 0.f) {
+                    for (auto i = _children.size(); i > 0u; --i)
+                        _resize_clamp_delta(*_children[i - 1u].get(), orientation_delta);
+                }
+
+                for (auto& child : _children)
+                    _resize_clamp_orthogonal(*child.get(), target_orthogonal_size);
+                for (auto& separator : _separators)
+                    _resize_clamp_orthogonal(*separator.get(), target_orthogonal_size);
+
+                _update_positions();
+                base::resize(width, height);
+
+                return true;
+            }
+            else {
+                return false;
+            }
+        }
+
+        void draw(NVGcontext *vg) override
+        {
+            base::draw_widgets(vg);
+        }
+
+        void draw_rect(NVGcontext *vg, const rectangle<>& area) override
+        {
+            //  Only the children in the area along the orientation, and the separators around them
+            const auto first = _child_index(_choose_dim(area.left, area.top));
+            const auto last = _child_index(_choose_dim(area.right, area.bottom));
+            const auto separator_end = std::min(last + 1u, _separators.size());
+
+            for (auto i = first > 0u ? first - 1u : 0u; i < separator_end; ++i)
+                base::draw_widget_rect(vg, _separators[i], area);
+            for (auto i = first; i <= last; ++i)
+                base::draw_widget_rect(vg, _children[i], area);
+        }
+
+        void set_frozen(bool frozen = true) noexcept
+        {
+            for (auto& separator : _separators)
+                static_cast<layout_separator*>(separator.get())->set_frozen(frozen);
+        }
+
+        auto size() const noexcept { return _children.size(); }
+
+    private:
+        /**
+         * Orientation abstraction helpers
+         **/
+        static auto _choose_dim(float width, float height)
+        {
+            if constexpr (Orientation == orientation::horizontal)
+                return width;
+            else
+                return height;
+        }
+
+        static auto _choose_dim_orthogonal(float width, float height)
+        {
+            if constexpr (Orientation == orientation::horizontal)
+                return height;
+            else
+                return width;
+        }
+
+        static auto _size(const widget& w) { return _choose_dim(w.width(), w.height()); }
+        static auto _orthogonal_size(const widget& w) { return _choose_dim_orthogonal(w.width(), w.height()); }
+
+        static const auto& _constraint(const widget& w)
+        {
+            if constexpr (Orientation == orientation::horizontal)
+                return w.width_constraint();
+            else
+                return w.height_constraint();
+        }
+
+        static const auto& _orthogonal_constraint(const widget& w)
+        {
+            if constexpr (Orientation == orientation::horizontal)
+                return w.height_constraint();
+            else
+                return w.width_constraint();
+        }
+
+        static void _resize(widget& w, float orientation_size, float orthogonal_size)
+        {
+            draw_profiler::scope trace{"resize", w};
+            if constexpr (Orientation == orientation::horizontal)
+                w.resize(orientation_size, orthogonal_size);
+            else
+                w.resize(orthogonal_size, orientation_size);
+        }
+
+        static void _resize_clamp_delta(widget& w, float& delta)
+        {
+            _resize(w, _constraint(w).clamp_delta(_size(w), delta), _orthogonal_size(w));
+        }
+
+        static void _resize_clamp_orthogonal(widget& w, float size)
+        {
+            _resize(w, _size(w), _orthogonal_constraint(w).clamp(size));
+        }
+
+        static float _layout_width(const std::vector<std::unique_ptr<widget>>& children)
+        {
+            float width = 0.f;
+            for (const auto& child : children) {
+                if constexpr (Orientation == orientation::horizontal)
+                    width += child->width();
+                else
+                    width = std::max(width, child->width());
+            }
+            return width;
+        }
+
+        static float _layout_height(const std::vector<std::unique_ptr<widget>>& children)
+        {
+            float height = 0.f;
+            for (const auto& child : children) {
+                if constexpr (Orientation == orientation::horizontal)
+                    height = std::max(height, child->height());
+                else
+                    height += child->height();
+            }
+            return height;
+        }
+
+        static void _set_position(widget_holder<>& holder, float pos)
+        {
+            if constexpr (Orientation == orientation::horizontal)
+                holder.set_pos_x(pos);
+            else
+                holder.set_pos_y(pos);
+        }
+
+        /**
+         *  \brief Position the children and separators from the children sizes
+         */
+        void _update_positions()
+        {
+            auto offset = 0.f;
+
+            for (auto i = 0u; i < _children.size(); ++i) {
+                _offsets[i] = offset;
+                _set_position(_children[i], offset);
+                offset += _size(*_children[i].get());
+            }
+
+            _offsets.back() = offset;
+
+            for (auto i = 0u; i < _separators.size(); ++i)
+                _set_position(_separators[i], _offsets[i + 1u] - _separator_width / 2.f);
+        }
+
+        /**
+         *  \return the index of the child at a position along the orientation, clamped to the children
+         */
+        std::size_t _child_index(float pos) const
+        {
+            const auto first_boundary = _offsets.begin() + 1;
+            const auto last_boundary = _offsets.end() - 1;
+            return static_cast<std::size_t>(std::upper_bound(first_boundary, last_boundary, pos) - first_boundary);
+        }
+
+        void _on_separator_drag(std::size_t index, float delta)
+        {
+            auto& first = *_children[index].get();
+            const auto target_first_size = _size(first) + delta;
+
+            //  The following children are resized together, as the second widget of a pair_layout
+            size_constraint next_constraint{0.f, 0.f};
+            auto next_size = 0.f;
+
+            for (auto i = index + 1u; i < _children.size(); ++i) {
+                next_constraint += _constraint(*_children[i].get());
+                next_size += _size(*_children[i].get());
+            }
+
+            if (_constraint(first).contains(target_first_size) &&
+                next_constraint.contains(next_size - delta))
+            {
+                _resize(first, target_first_size, _orthogonal_size(first));
+
+                auto next_delta = -delta;
+                for (auto i = _children.size(); i > index + 1u; --i)
+                    _resize_clamp_delta(*_children[i - 1u].get(), next_delta);
+
+                _update_positions();
+                base::invalidate();
+            }
+        }
+
+        widget_holder<> *widget_at(float x, float y)
+        {
+            const auto pos = _choose_dim(x, y);
+            const auto index = _child_index(pos);
+            constexpr auto half_separator = _separator_width / 2.f;
+
+            //  Separators are over the children borders
+            if (index > 0u && pos <= _offsets[index] + half_separator)
+                return &_separators[index - 1u];
+            else if (index + 1u < _children.size() && pos >= _offsets[index + 1u] - half_separator)
+                return &_separators[index];
+            else
+                return &_children[index];
+        }
+
+        template <typename TFunction>
+        void foreach_holder(TFunction func)
+        {
+            for (auto& separator : _separators)
+                func(separator);
+            for (auto& child : _children)
+                func(child);
+        }
+
+        std::vector<widget_holder<>> _children{};
+        std::vector<widget_holder<>> _separators{};
+        std::vector<float> _offsets{};      /**< Children positions along the orientation, and the layout size */
+    };
+
+    using horizontal_linear_layout = linear_layout<orientation::horizontal>;
+    using vertical_linear_layout = linear_layout<orientation::vertical>;
+
+    template <orientation O, bool Frozen, typename ...T>
+    auto make_linear_layout(T&& ...childs)
+    {
+        std::vector<std::unique_ptr<widget>> children{};
+        children.reserve(sizeof...(T));
+        (children.emplace_back(std::move(childs)), ...);
+
+        auto layout = std::make_unique<linear_layout<O>>(std::move(children));
+        layout->set_frozen(Frozen);
+        return layout;
+    }
+
+    template <bool Frozen = false, typename ...T>
+    auto make_horizontal_linear_layout(T&& ...childs)
+    {
+        return make_linear_layout<orientation::horizontal, Frozen>(std::move(childs)...);
+    }
+
+    template <bool Frozen = false, typename ...T>
+    auto make_vertical_linear_layout(T&& ...childs)
+    {
+        return make_linear_layout<orientation::vertical, Frozen>(std::move(childs)...);
+    }
+
+}
+
+#endif
@@ -111,7 +111,7 @@ namespace View {
     void map_wrapper::draw_rect(NVGcontext* vg, const rectangle<>& area)
     {
         //  Clip the drawing area
-        nvgIntersectScissor(vg, area.left, area.right, area.width(), area.height());
+        nvgIntersectScissor(vg, area.left, area.top, area.width(), area.height());
 
         //  Translate and draw
         nvgSave(vg);
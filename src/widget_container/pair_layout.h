@@ -36,6 +36,7 @@ namespace View {
         template <orientation O>
         auto resize(widget *p, float new_size)
         {
+            draw_profiler::scope trace{"resize", *p};
             if constexpr (O == orientation::horizontal)
                 return p->resize_width(new_size);
             else
@@ -45,6 +46,7 @@ namespace View {
         template <orientation O>
         auto resize(widget *p, float orientation_size, float orthogonal_size)
         {
+            draw_profiler::scope trace{"resize", *p};
             if constexpr (O == orientation::horizontal)
                 return p->resize(orientation_size, orthogonal_size);
             else
@@ -225,6 +227,11 @@ namespace View {
             widget_container<pair_layout<Orientation>>::draw_widgets(vg);
         }
 
+        void draw_rect(NVGcontext *vg, const rectangle<>& area) override
+        {
+            widget_container<pair_layout<Orientation>>::draw_widgets(vg, area);
+        }
+
         void set_frozen(bool frozen = true) noexcept
         {
             _separator_ref->set_frozen(frozen);
@@ -3,13 +3,72 @@
 
 #include <vector>
 #include <algorithm>
+#include <limits>
 #include "widget_container.h"
+#include "grid_index.h"
 
 namespace View {
 
+    template <typename TChildren>
+    class panel_implementation;
+
+    /**
+     *  \class panel_holder
+     *  \brief Widget holder that keep the panel index up to date
+     *  \details The child bounds are indexed again when it is moved or resized with the holder, and
+     *  when it is invalidated, as a child resized by other means is redrawn.
+     */
+    template <typename TChildren>
+    class panel_holder : public widget_holder<TChildren> {
+    public:
+        panel_holder(panel_implementation<TChildren>& owner, float x, float y, std::unique_ptr<TChildren>&& w)
+        :   widget_holder<TChildren>{owner, x, y, std::move(w)},
+            _owner{&owner}
+        {}
+
+        void set_pos(float x, float y)
+        {
+            widget_holder<TChildren>::set_pos(x, y);
+            _owner->_update_index(*this);
+        }
+
+        void set_pos_x(float x)
+        {
+            widget_holder<TChildren>::set_pos_x(x);
+            _owner->_update_index(*this);
+        }
+
+        void set_pos_y(float y)
+        {
+            widget_holder<TChildren>::set_pos_y(y);
+            _owner->_update_index(*this);
+        }
+
+        /**
+         *  \brief Resize the child
+         */
+        bool resize(float width, float height)
+        {
+            const auto resized = this->get()->resize(width, height);
+            _owner->_update_index(*this);
+            return resized;
+        }
+
+    protected:
+        void invalidate_rect(const rectangle<>& rect) override
+        {
+            _owner->_update_index(*this);
+            widget_holder<TChildren>::invalidate_rect(rect);
+        }
+
+    private:
+        panel_implementation<TChildren> *_owner;
+    };
+
     template <typename TChildren = widget>
     class panel_implementation : public widget_container<panel_implementation<TChildren>, TChildren> {
         friend class widget_container<panel_implementation<TChildren>, TChildren>;
+        friend class panel_holder<TChildren>;
         using implementation = widget_container<panel_implementation<TChildren>, TChildren>;
     public:
         panel_implementation(float width, float height)
@@ -25,18 +84,39 @@ namespace View {
         // drawing funcs
         void draw(NVGcontext *vg) override
         {
-            implementation::draw_widgets(vg);
+            _candidates.resize(_childrens.size());
+            for (auto i = 0u; i < _childrens.size(); ++i)
+                _candidates[i] = i;
+
+            _remove_hidden_candidates(nullptr);
+
+            for (auto id : _candidates)
+                implementation::draw_widget(vg, _childrens[id]);
         }
 
         void draw_rect(NVGcontext *vg, const rectangle<>&rect) override
         {
-            implementation::draw_widgets(vg, rect);
+            //  Only the children indexed near rect are visited, in drawing order
+            _refresh_index();
+            _index.overlapping(rect, _candidates);
+            _remove_hidden_candidates(&rect);
+
+            for (auto id : _candidates)
+                implementation::draw_widget_rect(vg, _childrens[id], rect);
         }
 
     protected:
-        widget_holder<TChildren>& insert_widget(float x, float y, std::unique_ptr<TChildren>&& w)
+        /**
+         *  \note The child must be moved and resized with the returned panel_holder (not with a
+         *  widget_holder reference), or invalidated, so that the panel index is updated
+         */
+        panel_holder<TChildren>& insert_widget(float x, float y, std::unique_ptr<TChildren>&& w)
         {
             auto& ret = _childrens.emplace_back(*this, x, y, std::move(w));
+
+            if (_index_valid)
+                _index.insert(_childrens.size() - 1u, _bounds_of(ret));
+
             implementation::invalidate();
             return ret;
         }
@@ -60,18 +140,26 @@ namespace View {
                 }),
                 _childrens.end());
 
+            //  Children indices have changed : the index is rebuilt when needed
+            _index_valid = false;
             implementation::invalidate();
         }
 
+        /**
+         *  \note Children are only hit inside their bounds
+         */
         widget_holder<TChildren> *widget_at(float x, float y)
         {
+            _refresh_index();
+            _index.at(x, y, _candidates);
+
             //  Last widget are in foreground
-            // TODO : Optimize (kd-tree ?)
-            for (auto it = _childrens.rbegin(); it != _childrens.rend(); ++it) {
-                const auto x_rel = x - it->pos_x();
-                const auto y_rel = y - it->pos_y();
-                if (it->get()->contains(x_rel, y_rel))
-                    return &(*it);
+            for (auto it = _candidates.rbegin(); it != _candidates.rend(); ++it) {
+                auto& holder = _childrens[*it];
+                const auto x_rel = x - holder.pos_x();
+                const auto y_rel = y - holder.pos_y();
+                if (holder.get()->contains(x_rel, y_rel))
+                    return &holder;
             }
             //  No widget at this position
             return nullptr;
@@ -83,7 +171,76 @@ namespace View {
             std::for_each(_childrens.begin(), _childrens.end(), func);
         }
 
-        std::vector<widget_holder<TChildren>> _childrens{};
+        std::vector<panel_holder<TChildren>> _childrens{};
+
+    private:
+        static auto _bounds_of(const widget_holder<TChildren>& holder)
+        {
+            return make_rectangle(
+                holder.pos_y(), holder.pos_y() + holder->height(),
+                holder.pos_x(), holder.pos_x() + holder->width());
+        }
+
+        void _update_index(const panel_holder<TChildren>& holder)
+        {
+            if (_index_valid && !_childrens.empty()) {
+                const auto id = static_cast<std::size_t>(&holder - _childrens.data());
+                if (id < _childrens.size())
+                    _index.insert(id, _bounds_of(holder));
+            }
+        }
+
+        /**
+         *  Occlusion culling : remove from the candidates the children whose visible part
+         *  (inside area, if any) is covered by the opaque rectangle of a sibling in front of them
+         */
+        void _remove_hidden_candidates(const rectangle<> *area)
+        {
+            constexpr auto hidden = std::numeric_limits<std::size_t>::max();
+            _opaque_rects.clear();
+
+            for (auto it = _candidates.rbegin(); it != _candidates.rend(); ++it) {
+                auto& holder = _childrens[*it];
+                auto visible = _bounds_of(holder);
+
+                if (area != nullptr && !area->intersect(visible, visible)) {
+                    *it = hidden;
+                    continue;
+                }
+
+                const bool covered = std::any_of(
+                    _opaque_rects.begin(), _opaque_rects.end(),
+                    [&visible](const auto& opaque) { return opaque.contains(visible); });
+
+                if (covered) {
+                    *it = hidden;
+                    continue;
+                }
+
+                const auto opaque = holder->opaque_rect();
+                if (opaque.width() > 0.f && opaque.height() > 0.f)
+                    _opaque_rects.push_back(opaque.translate(holder.pos_x(), holder.pos_y()));
+            }
+
+            _candidates.erase(
+                std::remove(_candidates.begin(), _candidates.end(), hidden),
+                _candidates.end());
+        }
+
+        void _refresh_index()
+        {
+            if (!_index_valid) {
+                _index.clear();
+                for (auto i = 0u; i < _childrens.size(); ++i)
+                    _index.insert(i, _bounds_of(_childrens[i]));
+                _index_valid = true;
+            }
+        }
+
+        grid_index _index{};
+        bool _index_valid{true};
+        std::vector<std::size_t> _candidates{};
+        std::vector<rectangle<>> _opaque_rects{};
     };
 
 
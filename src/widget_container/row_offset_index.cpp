@@ -0,0 +1,73 @@
+#include "row_offset_index.h"
+
+namespace View {
+
+    namespace {
+
+        std::size_t lowest_bit(std::size_t i) noexcept
+        {
+            return i & (~i + 1u);
+        }
+
+    }
+
+    void row_offset_index::assign(std::vector<float>&& heights)
+    {
+        _heights = std::move(heights);
+        _tree.assign(_heights.size() + 1u, 0.);
+
+        //  Linear construction : each node add its partial sum to its parent
+        for (auto i = 1u; i < _tree.size(); ++i) {
+            _tree[i] += _heights[i - 1u];
+            const auto parent = i + lowest_bit(i);
+            if (parent < _tree.size())
+                _tree[parent] += _tree[i];
+        }
+    }
+
+    void row_offset_index::set_height(std::size_t row, float height)
+    {
+        const double delta = static_cast<double>(height) - _heights[row];
+        _heights[row] = height;
+
+        for (auto i = row + 1u; i < _tree.size(); i += lowest_bit(i))
+            _tree[i] += delta;
+    }
+
+    float row_offset_index::offset(std::size_t row) const
+    {
+        double sum = 0.;
+
+        for (auto i = row; i > 0u; i -= lowest_bit(i))
+            sum += _tree[i];
+
+        return static_cast<float>(sum);
+    }
+
+    std::size_t row_offset_index::row_at(float offset) const
+    {
+        const auto count = _heights.size();
+
+        if (count == 0u)
+            return 0u;
+
+        //  Find the number of rows ending before offset
+        auto step = std::size_t{1u};
+        while (step * 2u <= count)
+            step *= 2u;
+
+        std::size_t row = 0u;
+        double remaining = offset;
+
+        for (; step > 0u; step /= 2u) {
+            const auto next = row + step;
+            if (next <= count && _tree[next] <= remaining) {
+                row = next;
+                remaining -= _tree[next];
+            }
+        }
+
+        return row < count ? row : count - 1u;
+    }
+
+}
@@ -0,0 +1,45 @@
+#ifndef VIEW_ROW_OFFSET_INDEX_H_
+#define VIEW_ROW_OFFSET_INDEX_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace View {
+
+    /**
+     *  \class row_offset_index
+     *  \brief Heights of a sequence of rows, indexed to find a row offset or the row at an offset
+     *  \details The prefix sums of the heights are kept in a Fenwick tree : changing a height,
+     *  computing an offset and finding the row at an offset are done in O(log n).
+     */
+    class row_offset_index {
+    public:
+        /**
+         *  \brief Replace the rows, in O(n)
+         */
+        void assign(std::vector<float>&& heights);
+
+        void set_height(std::size_t row, float height);
+        float height(std::size_t row) const { return _heights[row]; }
+
+        /**
+         *  \return the sum of the heights of the rows before row
+         */
+        float offset(std::size_t row) const;
+
+        /**
+         *  \return the row containing offset, clamped to the rows. 0 if there is no row
+         */
+        std::size_t row_at(float offset) const;
+
+        float total_height() const { return offset(_heights.size()); }
+        std::size_t size() const noexcept { return _heights.size(); }
+
+    private:
+        std::vector<float> _heights{};
+        std::vector<double> _tree{};        /**< 1-based Fenwick tree */
+    };
+
+}
+
+#endif
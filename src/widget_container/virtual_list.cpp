@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "virtual_list.h"
+
+namespace View {
+
+    virtual_list::virtual_list(virtual_list_model& model, float width, float height, std::size_t column_count)
+    :   widget_container<virtual_list>{width, height},
+        _model{model},
+        _column_count{column_count}
+    {
+        if (column_count == 0u)
+            throw std::runtime_error("View::virtual_list : column_count must not be 0");
+
+        _load_row_heights();
+        _update_displayed_items();
+    }
+
+    void virtual_list::reset()
+    {
+        std::fill(_bound_items.begin(), _bound_items.end(), _unbound);
+        _load_row_heights();
+        scroll_to(_scroll_offset);
+    }
+
+    void virtual_list::update_item(std::size_t item)
+    {
+        if (item >= _displayed_begin && item < _displayed_end) {
+            _model.bind_item(*_holder_of(item).get(), item);
+            _holder_of(item)->invalidate();
+        }
+    }
+
+    void virtual_list::update_row_height(std::size_t row)
+    {
+        _rows.set_height(row, _model.row_height(row));
+        _update_displayed_items();
+        invalidate();
+    }
+
+    void virtual_list::scroll_to(float offset)
+    {
+        const auto max_offset = std::max(0.f, content_height() - height());
+        _scroll_offset = std::clamp(offset, 0.f, max_offset);
+        _update_displayed_items();
+        invalidate();
+    }
+
+    void virtual_list::scroll_to_item(std::size_t item)
+    {
+        const auto row = item / _column_count;
+        if (row < _rows.size())
+            scroll_to(_rows.offset(row));
+    }
+
+    bool virtual_list::resize(float width, float height)
+    {
+        if (widget_container<virtual_list>::resize(width, height)) {
+            scroll_to(_scroll_offset);
+            return true;
+        }
+        else {
+            return false;
+        }
+    }
+
+    bool virtual_list::on_mouse_wheel(float x, float y, float distance)
+    {
+        if (!widget_container<virtual_list>::on_mouse_wheel(x, y, distance))
+            scroll_to(_scroll_offset - distance * scroll_step);
+        return true;
+    }
+
+    void virtual_list::apply_color_theme(const color_theme& theme)
+    {
+        //  Kept for the item widgets created later
+        _theme = theme;
+        widget_container<virtual_list>::apply_color_theme(theme);
+    }
+
+    void virtual_list::draw(NVGcontext *vg)
+    {
+        nvgIntersectScissor(vg, 0.f, 0.f, width(), height());
+
+        for (auto item = _displayed_begin; item < _displayed_end; ++item)
+            draw_widget(vg, _holder_of(item));
+    }
+
+    void virtual_list::draw_rect(NVGcontext *vg, const rectangle<>& area)
+    {
+        if (_displayed_begin == _displayed_end)
+            return;
+
+        nvgIntersectScissor(vg, area.left, area.top, area.width(), area.height());
+
+        //  Only the rows in the area
+        const auto first = std::max(_rows.row_at(area.top + _scroll_offset) * _column_count, _displayed_begin);
+        const auto last = std::min((_rows.row_at(area.bottom + _scroll_offset) + 1u) * _column_count, _displayed_end);
+
+        for (auto item = first; item < last; ++item)
+            draw_widget_rect(vg, _holder_of(item), area);
+    }
+
+    void virtual_list::_load_row_heights()
+    {
+        const auto row_count = (_model.item_count() + _column_count - 1u) / _column_count;
+        std::vector<float> heights(row_count);
+
+        for (auto row = 0u; row < row_count; ++row)
+            heights[row] = _model.row_height(row);
+
+        _rows.assign(std::move(heights));
+    }
+
+    void virtual_list::_update_displayed_items()
+    {
+        const auto item_count = _model.item_count();
+        const auto row_count = _rows.size();
+
+        if (row_count == 0u || height() <= 0.f) {
+            _displayed_begin = _displayed_end = 0u;
+            return;
+        }
+
+        //  Rows overlapping the list
+        const auto first_row = _rows.row_at(_scroll_offset);
+        const auto bottom = _scroll_offset + height();
+        auto end_row = first_row + 1u;
+
+        while (end_row < row_count && _rows.offset(end_row) < bottom)
+            end_row++;
+
+        _displayed_begin = first_row * _column_count;
+        _displayed_end = std::min(end_row * _column_count, item_count);
+
+        //  Create the missing widgets, with one more row for the partially displayed ones.
+        //  The item to widget mapping change : every widget must be bound again
+        const auto displayed_count = _displayed_end - _displayed_begin;
+
+        if (displayed_count > _item_widgets.size()) {
+            const auto widget_count = displayed_count + _column_count;
+
+            while (_item_widgets.size() < widget_count) {
+                auto item_widget = _model.create_item_widget();
+                if (_theme)
+                    item_widget->apply_color_theme(*_theme);
+                _item_widgets.emplace_back(*this, 0.f, 0.f, std::move(item_widget));
+            }
+
+            _bound_items.assign(widget_count, _unbound);
+        }
+
+        //  Bind and place the displayed items
+        const auto column_width = _column_width();
+
+        for (auto item = _displayed_begin; item < _displayed_end; ++item) {
+            const auto index = item % _item_widgets.size();
+            const auto row = item / _column_count;
+            auto& holder = _item_widgets[index];
+
+            if (_bound_items[index] != item) {
+                _model.bind_item(*holder.get(), item);
+                _bound_items[index] = item;
+            }
+
+            holder->resize(column_width, _rows.height(row));
+            holder.set_pos(
+                static_cast<float>(item % _column_count) * column_width,
+                _rows.offset(row) - _scroll_offset);
+        }
+    }
+
+    widget_holder<> *virtual_list::widget_at(float x, float y)
+    {
+        const auto content_y = y + _scroll_offset;
+
+        if (_displayed_begin == _displayed_end ||
+            x < 0.f || x >= width() || content_y < 0.f || content_y >= content_height())
+            return nullptr;
+
+        const auto row = _rows.row_at(content_y);
+        const auto column = std::min(
+            static_cast<std::size_t>(x / _column_width()), _column_count - 1u);
+        const auto item = row * _column_count + column;
+
+        if (item >= _displayed_begin && item < _displayed_end)
+            return &_holder_of(item);
+        else
+            return nullptr;
+    }
+
+}
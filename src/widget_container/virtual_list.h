@@ -0,0 +1,129 @@
+#ifndef VIEW_VIRTUAL_LIST_H_
+#define VIEW_VIRTUAL_LIST_H_
+
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include "widget_container.h"
+#include "row_offset_index.h"
+
+namespace View {
+
+    /**
+     *  \class virtual_list_model
+     *  \brief Items displayed by a virtual_list
+     *  \details Item widgets are created by the model and then recycled : a widget is bound to
+     *  an item when it is displayed, and is bound to an other item when it is scrolled out.
+     */
+    class virtual_list_model {
+    public:
+        static constexpr auto default_row_height = 20.f;
+
+        virtual ~virtual_list_model() = default;
+
+        virtual std::size_t item_count() const = 0;
+
+        /**
+         *  \brief Create a widget that can be bound to any item
+         */
+        virtual std::unique_ptr<widget> create_item_widget() = 0;
+
+        /**
+         *  \brief Display an item with a widget created by create_item_widget
+         */
+        virtual void bind_item(widget& item_widget, std::size_t item) = 0;
+
+        virtual float row_height(std::size_t row) const { return default_row_height; }
+    };
+
+    /**
+     *  \class virtual_list
+     *  \brief Scrollable list, or grid, of items where only the displayed items have a widget
+     *  \details Items are placed in rows of column_count items, filling the list width.
+     *  The model item widgets are only created to fill the list height, and are bound to the
+     *  displayed items when the list is scrolled. The model must outlive the list.
+     */
+    class virtual_list : public widget_container<virtual_list> {
+        friend class widget_container<virtual_list>;
+
+    public:
+        static constexpr auto scroll_step = 20.f;
+
+        virtual_list(virtual_list_model& model, float width, float height, std::size_t column_count = 1u);
+        ~virtual_list() override = default;
+
+        /**
+         *  \brief Reload the items and row heights, after the model was changed
+         */
+        void reset();
+
+        /**
+         *  \brief Bind again an item, if it is displayed
+         */
+        void update_item(std::size_t item);
+
+        /**
+         *  \brief Reload the height of a row
+         */
+        void update_row_height(std::size_t row);
+
+        /**
+         *  \brief Scroll so that offset, in content coordinates, is at the list top
+         */
+        void scroll_to(float offset);
+
+        /**
+         *  \brief Scroll so that the row of an item is at the list top
+         */
+        void scroll_to_item(std::size_t item);
+
+        float scroll_offset() const noexcept { return _scroll_offset; }
+        float content_height() const { return _rows.total_height(); }
+        std::size_t column_count() const noexcept { return _column_count; }
+
+        /**
+         *  \return the number of item widgets created by the model
+         */
+        std::size_t item_widget_count() const noexcept { return _item_widgets.size(); }
+
+        bool resize(float width, float height) override;
+        bool on_mouse_wheel(float x, float y, float distance) override;
+        void apply_color_theme(const color_theme& theme) override;
+
+        void draw(NVGcontext *vg) override;
+        void draw_rect(NVGcontext *vg, const rectangle<>& area) override;
+
+    private:
+        static constexpr auto _unbound = static_cast<std::size_t>(-1);
+
+        void _load_row_heights();
+        void _update_displayed_items();
+        widget_holder<>& _holder_of(std::size_t item) { return _item_widgets[item % _item_widgets.size()]; }
+        float _column_width() const noexcept { return width() / static_cast<float>(_column_count); }
+
+        widget_holder<> *widget_at(float x, float y);
+
+        template <typename TFunction>
+        void foreach_holder(TFunction func)
+        {
+            for (auto& holder : _item_widgets)
+                func(holder);
+        }
+
+        virtual_list_model& _model;
+        const std::size_t _column_count;
+        row_offset_index _rows{};
+        float _scroll_offset{0.f};
+
+        //  Item i is displayed by _item_widgets[i % size], stable when new widgets are added
+        std::deque<widget_holder<>> _item_widgets{};
+        std::vector<std::size_t> _bound_items{};
+        std::size_t _displayed_begin{0u};
+        std::size_t _displayed_end{0u};
+        std::optional<color_theme> _theme{};
+    };
+
+}
+
+#endif
@@ -5,6 +5,7 @@
 
 #include "widget/widget.h"
 #include "display/common/display_controler.h"
+#include "helpers/draw_profiler.h"
 
 namespace View {
 
@@ -123,6 +124,16 @@ namespace View {
         void draw_widgets(NVGcontext *vg);
         void draw_widgets(NVGcontext *vg, const rectangle<>& rect);
 
+        /**
+         *  \brief Draw a child entirely
+         */
+        void draw_widget(NVGcontext *vg, widget_holder<TChildren>& holder);
+
+        /**
+         *  \brief Redraw the part of a child that overlap with rect
+         */
+        void draw_widget_rect(NVGcontext *vg, widget_holder<TChildren>& holder, const rectangle<>& rect);
+
         auto focused_widget() const noexcept { return _focused_widget; }
         void reset_focused_widget() noexcept { _focused_widget = nullptr; }
 
@@ -145,8 +156,10 @@ namespace View {
     template <typename TDerived, typename TChildren>
     bool  widget_container<TDerived, TChildren>::on_char_input(char c)
     {
-        if (_focused_widget)
+        if (_focused_widget) {
+            draw_profiler::scope trace{"on_char_input", *_focused_widget->get()};
             return _focused_widget->get()->on_char_input(c);
+        }
         else
             return false;
     }
@@ -179,6 +192,7 @@ namespace View {
             if (child == _focused_widget) {
                 const auto x_rel = x - _focused_widget->pos_x();
                 const auto y_rel = y - _focused_widget->pos_y();
+                draw_profiler::scope trace{"on_mouse_move", *_focused_widget->get()};
                 return _focused_widget->get()->on_mouse_move(x_rel, y_rel);
             }
             else {
@@ -207,8 +221,10 @@ namespace View {
     template <typename TDerived, typename TChildren>
     bool widget_container<TDerived, TChildren>::on_mouse_wheel(float x, float y, float distance)
     {
-        if (_focused_widget)
+        if (_focused_widget) {
+            draw_profiler::scope trace{"on_mouse_wheel", *_focused_widget->get()};
             return _focused_widget->get()->on_mouse_wheel(x, y, distance);
+        }
         else
             return false;
     }
@@ -216,11 +232,13 @@ namespace View {
     template <typename TDerived, typename TChildren>
     bool widget_container<TDerived, TChildren>::on_mouse_button_down(const mouse_button button, float x, float y)
     {
-        if (_focused_widget)
+        if (_focused_widget) {
+            draw_profiler::scope trace{"on_mouse_button_down", *_focused_widget->get()};
             return _focused_widget->get()->on_mouse_button_down(
                 button,
                 x - _focused_widget->pos_x(),
                 y - _focused_widget->pos_y());
+        }
         else
             return false;
     }
@@ -228,11 +246,13 @@ namespace View {
     template <typename TDerived, typename TChildren>
     bool widget_container<TDerived, TChildren>::on_mouse_button_up(const mouse_button button, float x, float y)
     {
-        if (_focused_widget)
+        if (_focused_widget) {
+            draw_profiler::scope trace{"on_mouse_button_up", *_focused_widget->get()};
             return _focused_widget->get()->on_mouse_button_up(
                 button,
                 x - _focused_widget->pos_x(),
                 y - _focused_widget->pos_y());
+        }
         else
             return false;
     }
@@ -240,10 +260,12 @@ namespace View {
     template <typename TDerived, typename TChildren>
     bool widget_container<TDerived, TChildren>::on_mouse_dbl_click(float x, float y)
     {
-        if (_focused_widget)
+        if (_focused_widget) {
+            draw_profiler::scope trace{"on_mouse_dbl_click", *_focused_widget->get()};
             return _focused_widget->get()->on_mouse_dbl_click(
                 x - _focused_widget->pos_x(),
                 y - _focused_widget->pos_y());
+        }
         else
             return false;
     }
@@ -267,6 +289,7 @@ namespace View {
     bool widget_container<TDerived, TChildren>::on_mouse_drag(const mouse_button button, float x, float y, float dx, float dy)
     {
         if (_draging && _focused_widget) {
+            draw_profiler::scope trace{"on_mouse_drag", *_focused_widget->get()};
             return _focused_widget->get()->on_mouse_drag(
                 button,
                 x - _focused_widget->pos_x(),
@@ -333,35 +356,50 @@ namespace View {
     template <typename TDerived, typename TChildren>
     void widget_container<TDerived, TChildren>::draw_widgets(NVGcontext *vg)
     {
-        foreach_holder([vg](auto& holder) {
-            nvgSave(vg);
-            nvgTranslate(vg, holder.pos_x(), holder.pos_y());
-            holder->draw(vg);
-            nvgRestore(vg);
+        foreach_holder([this, vg](auto& holder) {
+            draw_widget(vg, holder);
         });
     }
 
+    template <typename TDerived, typename TChildren>
+    void widget_container<TDerived, TChildren>::draw_widget(NVGcontext *vg, widget_holder<TChildren>& holder)
+    {
+        nvgSave(vg);
+        nvgTranslate(vg, holder.pos_x(), holder.pos_y());
+        draw_profiler::scope trace{"draw", *holder.get()};
+        holder->draw(vg);
+        nvgRestore(vg);
+    }
+
     template <typename TDerived, typename TChildren>
     void widget_container<TDerived, TChildren>::draw_widgets(NVGcontext *vg, const rectangle<>& rect)
     {
-        foreach_holder([vg, &rect](auto& holder) {
-            const auto child_rect = make_rectangle(
-                holder.pos_y(), holder.pos_y() + holder->height(),
-                holder.pos_x(), holder.pos_x() + holder->width());
-
-            rectangle<> drawing_rect;
-
-            //  Redraw only widget that overlap with rect
-            if (rect.intersect(child_rect, drawing_rect)) {
-                nvgSave(vg);
-                nvgTranslate(vg, holder.pos_x(), holder.pos_y());
-                holder.get()->draw_rect(
-                    vg, drawing_rect.translate(-holder.pos_x(), -holder.pos_y()));
-                nvgRestore(vg);
-            }
+        foreach_holder([this, vg, &rect](auto& holder) {
+            draw_widget_rect(vg, holder, rect);
         });
     }
 
+    template <typename TDerived, typename TChildren>
+    void widget_container<TDerived, TChildren>::draw_widget_rect(
+        NVGcontext *vg, widget_holder<TChildren>& holder, const rectangle<>& rect)
+    {
+        const auto child_rect = make_rectangle(
+            holder.pos_y(), holder.pos_y() + holder->height(),
+            holder.pos_x(), holder.pos_x() + holder->width());
+
+        rectangle<> drawing_rect;
+
+        //  Redraw only widget that overlap with rect
+        if (rect.intersect(child_rect, drawing_rect)) {
+            nvgSave(vg);
+            nvgTranslate(vg, holder.pos_x(), holder.pos_y());
+            draw_profiler::scope trace{"draw_rect", *holder.get()};
+            holder.get()->draw_rect(
+                vg, drawing_rect.translate(-holder.pos_x(), -holder.pos_y()));
+            nvgRestore(vg);
+        }
+    }
+
 }
 
 #endif
\ No newline at end of file